@@ -0,0 +1,95 @@
+#include"BOKPHeuristic.h"
+
+#include<algorithm>
+#include<numeric>
+
+/********************************************************************************************/
+BOKPHeuristic::BOKPHeuristic ( int n, int cap, const std::vector<int>& w, const std::vector<int>& p1, const std::vector<int>& p2, int weights ):
+    n ( n ),
+    cap ( cap ),
+    w ( w.begin ( ) , w.begin ( ) + n ),
+    p1 ( p1.begin ( ) , p1.begin ( ) + n ),
+    p2 ( p2.begin ( ) , p2.begin ( ) + n ),
+    Weights ( std::max ( 1 , weights ) )
+{}
+
+/********************************************************************************************/
+void BOKPHeuristic::operator() ( std::list< solution > &candidates ) const
+{
+    std::vector< double > cost ( n );
+    std::vector< int > order ( n );
+    std::vector< char > x ( n );
+    for ( int k = 0; k < Weights; ++k )
+    {
+        // Weight vectors spread evenly from ( 1 , 0 ) to ( 0 , 1 )
+        double t = ( Weights > 1 ) ? double ( k ) / ( Weights - 1 ) : 0.5;
+        for ( int i = 0; i < n; ++i ) cost[i] = ( 1.0 - t ) * p1[i] + t * p2[i];
+
+        // Greedy: take the items with the lowest cost per unit of weight until the capacity constraint holds
+        std::iota ( order.begin ( ) , order.end ( ) , 0 );
+        std::sort ( order.begin ( ) , order.end ( ) , [&] ( int a, int b ) { return cost[a] * w[b] < cost[b] * w[a]; } );
+        std::fill ( x.begin ( ) , x.end ( ) , 0 );
+        long weight = 0;
+        for ( auto it = order.begin ( ); it != order.end ( ) && weight < cap; ++it )
+        {
+            x[*it] = 1;
+            weight += w[*it];
+        }
+        if ( weight < cap ) return; // Even all items do not satisfy the constraint
+
+        LocalSearch ( cost , x , weight );
+
+        std::pair< double , double > p ( 0.0 , 0.0 );
+        std::vector< double > VarVals ( n );
+        for ( int i = 0; i < n; ++i )
+        {
+            VarVals[i] = x[i];
+            if ( x[i] )
+            {
+                p.first += p1[i];
+                p.second += p2[i];
+            }
+        }
+        candidates.push_back ( solution ( false , p , VarVals ) );
+    }
+}
+
+/********************************************************************************************/
+void BOKPHeuristic::LocalSearch ( const std::vector< double > &cost, std::vector< char > &x, long &weight ) const
+{
+    std::vector< int > in;  // Items in the knapsack, most expensive first
+    for ( int i = 0; i < n; ++i ) if ( x[i] ) in.push_back ( i );
+    std::sort ( in.begin ( ) , in.end ( ) , [&] ( int a, int b ) { return cost[a] > cost[b]; } );
+
+    // Remove redundant items
+    for ( auto it = in.begin ( ); it != in.end ( ); ++it )
+    {
+        if ( weight - w[*it] >= cap )
+        {
+            x[*it] = 0;
+            weight -= w[*it];
+        }
+    }
+
+    // Swap an item in the knapsack with the cheapest item outside it which keeps the constraint satisfied. Every swap lowers the cost
+    bool improved = true;
+    for ( int sweep = 0; improved && sweep < 10; ++sweep )
+    {
+        improved = false;
+        for ( int i = 0; i < n; ++i )
+        {
+            if ( !x[i] ) continue;
+            int best = -1;
+            for ( int j = 0; j < n; ++j )
+            {
+                if ( x[j] || cost[j] >= cost[i] || weight - w[i] + w[j] < cap ) continue;
+                if ( best < 0 || cost[j] < cost[best] ) best = j;
+            }
+            if ( best < 0 ) continue;
+            x[i] = 0;
+            x[best] = 1;
+            weight += w[best] - w[i];
+            improved = true;
+        }
+    }
+}
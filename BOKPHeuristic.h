@@ -0,0 +1,55 @@
+#ifndef BOKPHEURISTIC_H_INCLUDED
+#define BOKPHEURISTIC_H_INCLUDED
+
+/**
+ * Heuristic for the bi-objective knapsack problem built by CplexModel::buildBOKP, used as the problem specific part of phase zero in tpm.
+ * For a number of weight vectors, a weighted greedy fills the knapsack and a local search removes redundant items and swaps pairs of items.
+ * No solver is used. Item i is the variable AllVars[i], so the model must have been built by buildBOKP on an empty CplexModel.
+ */
+
+//! C++ includes
+#include<vector>
+#include<list>
+
+//! My own C++ includes
+#include"solution.h"
+
+class BOKPHeuristic{
+    private:
+        int n;                  //!< Number of items
+        int cap;                //!< Total weight of the items chosen must be at least cap
+        std::vector<int> w;     //!< Weight of each item
+        std::vector<int> p1;    //!< Coefficient of each item in the first objective
+        std::vector<int> p2;    //!< Coefficient of each item in the second objective
+        int Weights;            //!< Number of weight vectors the greedy is run for
+
+        /*! \brief Improves a solution for a weight vector
+         *
+         * Removes items, most expensive first, as long as the capacity constraint holds. Then swaps an item in the knapsack with a cheaper
+         * item outside it as long as the capacity constraint holds, for a few sweeps or until no swap improves the weighted cost.
+         * \param cost constant reference to a vector of doubles. The weighted cost of each item
+         * \param x reference to a vector of chars. One for the items in the knapsack. Improved on output
+         * \param weight reference to an integer. The total weight of the items in the knapsack. Updated on output
+         */
+        void LocalSearch ( const std::vector< double > &cost, std::vector< char > &x, long &weight ) const;
+
+    public:
+        /*! \brief Constructor taking the same data as CplexModel::buildBOKP
+         * \param n integer. Number of items
+         * \param cap integer. The capacity of the knapsack
+         * \param w constant reference to a vector of integers. The weight of each item
+         * \param p1 constant reference to a vector of integers. The profit of each item in the first objective
+         * \param p2 constant reference to a vector of integers. The profit of each item in the second objective
+         * \param weights integer. Number of weight vectors. Default is 20
+         */
+        BOKPHeuristic ( int n, int cap, const std::vector<int>& w, const std::vector<int>& p1, const std::vector<int>& p2, int weights = 20 );
+
+        /*! \brief Runs the heuristic
+         *
+         * Appends one solution per weight vector to candidates. The solutions may dominate each other, and some may be equal.
+         * \param candidates reference to a list of solutions
+         */
+        void operator() ( std::list< solution > &candidates ) const;
+};
+
+#endif // BOKPHEURISTIC_H_INCLUDED
@@ -0,0 +1,44 @@
+#include"BatchSolver.h"
+
+/********************************************************************************************/
+BatchSolver::BatchSolver ( ) {}
+
+/********************************************************************************************/
+size_t BatchSolver::run ( const InstanceBuilder& builder, const ResultConsumer& consumer )
+{
+    size_t instance = 0;
+    try
+    {
+        BatchResult result;
+        while ( builder ( instance , theModel , theTPM ) )
+        {
+            result.Instance     = instance;
+            result.Status       = theTPM.RUN ( theModel );
+            result.Statistics   = *theTPM.getTestStatistics ( );
+            result.Frontier     = theTPM.getNonDominatedSet ( );
+            consumer ( result );
+            ++instance;
+        }
+        // Release the memory held by the last frontier
+        theTPM.reset ( );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in run in the BatchSolver class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in run in the BatchSolver class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    return instance;
+}
+
+/********************************************************************************************/
+std::vector< BatchResult > BatchSolver::run ( const InstanceBuilder& builder )
+{
+    std::vector< BatchResult > results;
+    run ( builder , [&results] ( BatchResult& result ) { results.push_back ( std::move ( result ) ); } );
+    return results;
+}
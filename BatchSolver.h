@@ -0,0 +1,69 @@
+#ifndef BATCHSOLVER_H_INCLUDED
+#define BATCHSOLVER_H_INCLUDED
+
+/**
+ * Class used to solve a stream of instances (or parameter variants of the same instance) with the two phase method,
+ * reusing the same IloEnv, CplexModel and tpm object for every run.
+ */
+
+//! C++ includes
+#include<list>
+#include<vector>
+#include<functional>
+#include<exception>
+
+//! My own C++ includes
+#include"tpm.h"         //! The two phase method
+#include"CplexModel.h"  //! The class holding the cplex model
+#include"solution.h"    //! The solution class
+
+struct BatchResult{
+    size_t Instance;                //!< Index of the instance in the stream
+    int Status;                     //!< Return value of tpm::RUN. Zero if all went well
+    testStatistics Statistics;      //!< Test statistics of the run
+    std::list< solution > Frontier; //!< The non--dominated frontier found
+    std::exception_ptr Error;       //!< The exception thrown by user code which ended the run, if any. Null if all went well. Errors inside CplexModel and tpm end the process
+}; //!< Struct used to hold the result of a single run in a batch
+
+/*!
+ * Function type used to feed instances to the BatchSolver. It is called with the index of the instance, the CplexModel and the tpm
+ * object the instance is solved with. In order to solve a new instance, call theModel.reset ( ) and build the new instance. In order to solve
+ * a parameter variant of the previous instance, leave theModel as it is and change the settings of theTPM. An instance held by a ModelData is build by
+ * theModel.reset ( ) followed by theModel.build ( data ). Return false when the stream is exhausted.
+ */
+typedef std::function< bool ( size_t instance, CplexModel& theModel, tpm& theTPM ) > InstanceBuilder;
+
+/*!
+ * Function type used to hand results to the caller as soon as an instance is solved
+ */
+typedef std::function< void ( BatchResult& result ) > ResultConsumer;
+
+class BatchSolver{
+    private:
+        CplexModel theModel;    //!< The model reused for all instances. Its environment lives as long as the BatchSolver
+        tpm theTPM;             //!< The tpm object reused for all instances
+
+    public:
+        /*!
+         * Default constructor. Creates the environment, the model and the tpm object used throughout the batch
+         */
+        BatchSolver ( );
+
+        /*! \brief Solves a stream of instances and hands each result to a consumer
+         *
+         * Calls builder for instance 0, 1, 2, ... until it returns false. After each build, tpm::RUN is called and the result is handed to consumer.
+         * As tpm::RUN restores the model after solving, no state leaks from one instance to the next.
+         * \param builder constant reference to an InstanceBuilder. Builds (or modifies) the next instance
+         * \param consumer constant reference to a ResultConsumer. Receives the result of each instance
+         * \return size_t. The number of instances solved
+         */
+        size_t run ( const InstanceBuilder& builder, const ResultConsumer& consumer );
+
+        /*! \brief Solves a stream of instances and returns all results
+         * \param builder constant reference to an InstanceBuilder. Builds (or modifies) the next instance
+         * \return vector of BatchResults. One result per instance, in the order the instances were build
+         */
+        std::vector< BatchResult > run ( const InstanceBuilder& builder );
+};
+
+#endif // BATCHSOLVER_H_INCLUDED
@@ -0,0 +1,153 @@
+#ifndef BOXQUEUE_H_INCLUDED
+#define BOXQUEUE_H_INCLUDED
+
+/**
+ * Class template implementing the list of pending boxes of the perpendicular search method with a bound on the number of boxes kept in memory.
+ * Boxes are taken from the front (first in, first out) or from the back (last in, first out). When more than the allowed number of boxes are
+ * pending, chunks of the boxes which will be taken last are written to an anonymous temporary file, and they are read back in order when they are needed.
+ * T must be trivially copyable, as it is written to the file byte by byte.
+ */
+
+//! C++ includes
+#include<deque>
+#include<vector>
+#include<cstdio>
+#include<stdexcept>
+#include<type_traits>
+#include<algorithm>
+
+template< class T >
+class BoxQueue{
+    static_assert ( std::is_trivially_copyable< T >::value , "BoxQueue can only spill trivially copyable types" );
+
+    private:
+        struct CHUNK{
+            long long Offset;   //!< Offset of the chunk in the file
+            size_t Size;        //!< Number of boxes in the chunk
+        }; //!< Struct describing a chunk of boxes written to the file
+
+        bool TakeFront;         //!< If true, boxes are taken from the front, otherwise from the back
+        size_t MaxInMemory;     //!< Maximum number of boxes kept in memory. Zero means no limit
+        size_t ChunkSize;       //!< Number of boxes written to the file at a time
+        std::deque< T > Head;   //!< Boxes to be taken next. Only used when taking from the front
+        std::deque< T > Tail;   //!< Boxes added last
+        std::deque< CHUNK > Chunks; //!< Chunks in the file, in the order of the boxes they hold
+        std::FILE *File;        //!< The temporary file. Created when the first chunk is written
+        long long End;          //!< Offset of the end of the used part of the file
+        size_t Size;            //!< Total number of boxes pending
+        size_t Spilled;         //!< Number of boxes written to the file so far
+
+        /*!
+         * Writes the ChunkSize boxes of Tail which will be taken last to the file
+         */
+        void spill ( )
+        {
+            if ( Tail.size ( ) < ChunkSize ) return; // Head holds most of the boxes. It is emptied before more are read
+            if ( File == nullptr && ( File = std::tmpfile ( ) ) == nullptr ) throw std::runtime_error ( "Could not create the temporary file of the box queue" );
+            // From the front, the oldest boxes of Tail are taken after the chunks already written. From the back, they are taken last of all
+            std::vector< T > chunk ( Tail.begin ( ) , Tail.begin ( ) + ChunkSize );
+            Tail.erase ( Tail.begin ( ) , Tail.begin ( ) + ChunkSize );
+            if ( fseeko ( File , End , SEEK_SET ) != 0 || std::fwrite ( chunk.data ( ) , sizeof ( T ) , ChunkSize , File ) != ChunkSize )
+                throw std::runtime_error ( "Could not write to the temporary file of the box queue" );
+            Chunks.push_back ( { End , ChunkSize } );
+            End += ChunkSize * sizeof ( T );
+            Spilled += ChunkSize;
+        }
+
+        /*!
+         * Reads a chunk back from the file into q
+         */
+        void load ( const CHUNK &chunk, std::deque< T > &q )
+        {
+            std::vector< T > boxes ( chunk.Size );
+            if ( fseeko ( File , chunk.Offset , SEEK_SET ) != 0 || std::fread ( boxes.data ( ) , sizeof ( T ) , chunk.Size , File ) != chunk.Size )
+                throw std::runtime_error ( "Could not read from the temporary file of the box queue" );
+            q.insert ( q.begin ( ) , boxes.begin ( ) , boxes.end ( ) );
+        }
+
+    public:
+        /*! \brief Constructor
+         * \param takeFront boolean. If true, boxes are taken from the front, otherwise from the back
+         * \param maxInMemory size_t. Maximum number of boxes kept in memory. Zero means no limit
+         */
+        BoxQueue ( bool takeFront, size_t maxInMemory = 0 ):
+            TakeFront ( takeFront ),
+            MaxInMemory ( maxInMemory ),
+            ChunkSize ( std::max< size_t > ( 1 , maxInMemory / 4 ) ),
+            File ( nullptr ),
+            End ( 0 ),
+            Size ( 0 ),
+            Spilled ( 0 )
+        {}
+
+        /*!
+         * Destructor. Closes and removes the temporary file
+         */
+        ~BoxQueue ( ) { if ( File != nullptr ) std::fclose ( File ); }
+
+        BoxQueue ( const BoxQueue& ) = delete;
+        BoxQueue& operator= ( const BoxQueue& ) = delete;
+
+        /*!
+         * Returns true if no boxes are pending
+         */
+        bool empty ( ) const { return Size == 0; }
+
+        /*!
+         * Returns the number of boxes pending
+         */
+        size_t size ( ) const { return Size; }
+
+        /*!
+         * Returns the number of boxes written to the file so far
+         */
+        size_t getNumberOfSpilledBoxes ( ) const { return Spilled; }
+
+        /*! \brief Adds a box
+         * \param box constant reference to a T. The box to add
+         */
+        void push ( const T &box )
+        {
+            Tail.push_back ( box );
+            ++Size;
+            if ( MaxInMemory > 0 && Head.size ( ) + Tail.size ( ) > MaxInMemory ) spill ( );
+        }
+
+        /*! \brief Takes the next box
+         * \return T. The box taken. The queue must not be empty
+         */
+        T pop ( )
+        {
+            T box;
+            if ( TakeFront )
+            {
+                if ( Head.empty ( ) )
+                {
+                    if ( !Chunks.empty ( ) )
+                    {
+                        load ( Chunks.front ( ) , Head );
+                        Chunks.pop_front ( );
+                        if ( Chunks.empty ( ) ) End = 0; // The file can be reused from the beginning
+                    }
+                    else Head.swap ( Tail );
+                }
+                box = Head.front ( );
+                Head.pop_front ( );
+            }
+            else
+            {
+                if ( Tail.empty ( ) )
+                {   // The most recently written chunk holds the boxes to take next. Its space in the file is reused
+                    load ( Chunks.back ( ) , Tail );
+                    End = Chunks.back ( ).Offset;
+                    Chunks.pop_back ( );
+                }
+                box = Tail.back ( );
+                Tail.pop_back ( );
+            }
+            --Size;
+            return box;
+        }
+};
+
+#endif // BOXQUEUE_H_INCLUDED
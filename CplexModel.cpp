@@ -1,7 +1,25 @@
 #include"CplexModel.h"
 
+#include<cmath>
+#include<limits>
+#include<unordered_map>
+#include<unordered_set>
+
 /*****************************************************************************************/
 CplexModel::CplexModel()
+{
+    init ( );
+}
+
+/*****************************************************************************************/
+CplexModel::CplexModel ( const std::shared_ptr< const ModelData > &data )
+{
+    init ( );
+    build ( data );
+}
+
+/*****************************************************************************************/
+void CplexModel::init ( )
 {
     model = IloModel ( env );
     cplex = IloCplex ( model );
@@ -12,6 +30,24 @@ CplexModel::CplexModel()
     f2 = IloNumVar ( env, 0 , IloInfinity, ILOFLOAT , "f2" );
     OBJ = IloMinimize ( env , f1 + f2 );
     AllVars = IloNumVarArray( env );
+    Rows = IloRangeArray( env );
+
+    // State used by the fast modification functions
+    F1LB = F2LB = 0.0;
+    F1UB = F2UB = IloInfinity;
+    W1 = W2 = 1.0;
+    ObjVars = IloNumVarArray ( env );
+    ObjVars.add ( f1 );
+    ObjVars.add ( f2 );
+    LBBuffer = IloNumArray ( env , 2 );
+    UBBuffer = IloNumArray ( env , 2 );
+    WeightBuffer = IloNumArray ( env , 2 );
+    IntParams.clear ( );
+    NumParams.clear ( );
+
+    // Nothing is recorded before the first bulk building function is called
+    Data.reset ( );
+    Recording = true;
 }
 
 /*****************************************************************************************/
@@ -22,6 +58,18 @@ CplexModel::~CplexModel()
         AllVars.endElements ( );
         AllVars.end ( );
     }
+    if ( Rows.getImpl() != nullptr )
+    {   // End all constraints added through the bulk building functions and end the array used to store them
+        Rows.endElements ( );
+        Rows.end ( );
+    }
+    if ( ObjVars.getImpl ( ) != nullptr )
+    {   // End the array { f1 , f2 } and the buffers used to change them
+        ObjVars.end ( );
+        LBBuffer.end ( );
+        UBBuffer.end ( );
+        WeightBuffer.end ( );
+    }
     if ( f1.getImpl ( ) != nullptr )
     {   // End f1
         f1.end ( );
@@ -49,43 +97,540 @@ CplexModel::~CplexModel()
 
 }
 
+/*****************************************************************************************/
+void CplexModel::setObjectiveBounds ( double lb1, double ub1, double lb2, double ub2 )
+{
+    try{
+        bool Change1 = ( lb1 != F1LB ) || ( ub1 != F1UB );
+        bool Change2 = ( lb2 != F2LB ) || ( ub2 != F2UB );
+        if ( Change1 && Change2 )
+        {   // Change both variables in one call
+            LBBuffer[0] = lb1;
+            LBBuffer[1] = lb2;
+            UBBuffer[0] = ub1;
+            UBBuffer[1] = ub2;
+            ObjVars.setBounds ( LBBuffer , UBBuffer );
+        }
+        else if ( Change1 ) f1.setBounds ( lb1 , ub1 );
+        else if ( Change2 ) f2.setBounds ( lb2 , ub2 );
+        F1LB = lb1;
+        F1UB = ub1;
+        F2LB = lb2;
+        F2UB = ub2;
+    }catch(IloException &ie){
+        std::cerr << "IloException in the setObjectiveBounds of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::setWeights ( double w1, double w2 )
+{
+    try{
+        bool Change1 = ( w1 != W1 );
+        bool Change2 = ( w2 != W2 );
+        if ( Change1 && Change2 )
+        {   // Change both coefficients in one call
+            WeightBuffer[0] = w1;
+            WeightBuffer[1] = w2;
+            OBJ.setLinearCoefs ( ObjVars , WeightBuffer );
+        }
+        else if ( Change1 ) OBJ.setLinearCoef ( f1 , w1 );
+        else if ( Change2 ) OBJ.setLinearCoef ( f2 , w2 );
+        W1 = w1;
+        W2 = w2;
+    }catch(IloException &ie){
+        std::cerr << "IloException in the setWeights of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::getWeights ( double &w1, double &w2 )
+{
+    try{
+        if ( W1 == W1 && W2 == W2 )
+        {   // Not NaN, so the cache is valid
+            w1 = W1;
+            w2 = W2;
+            return;
+        }
+        w1 = w2 = 0.0;
+        IloExpr expr = OBJ.getExpr ( );
+        for ( IloExpr::LinearIterator it = expr.getLinearIterator ( ); it.ok ( ); ++it )
+        {
+            if ( it.getVar ( ).getId ( ) == f1.getId ( ) ) w1 = it.getCoef ( );
+            else if ( it.getVar ( ).getId ( ) == f2.getId ( ) ) w2 = it.getCoef ( );
+        }
+        W1 = w1;
+        W2 = w2;
+    }catch(IloException &ie){
+        std::cerr << "IloException in the getWeights of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::setParameter ( IloCplex::IntParam param, IloInt value )
+{
+    auto it = IntParams.find ( param );
+    if ( it != IntParams.end ( ) && it->second == value ) return;
+    cplex.setParam ( param , value );
+    IntParams[param] = value;
+}
+
+/*****************************************************************************************/
+void CplexModel::setParameter ( IloCplex::NumParam param, double value )
+{
+    auto it = NumParams.find ( param );
+    if ( it != NumParams.end ( ) && it->second == value ) return;
+    cplex.setParam ( param , value );
+    NumParams[param] = value;
+}
+
+/*****************************************************************************************/
+void CplexModel::synchronize ( )
+{
+    F1LB = f1.getLB ( );
+    F1UB = f1.getUB ( );
+    F2LB = f2.getLB ( );
+    F2UB = f2.getUB ( );
+    // The weights cannot be read cheaply from OBJ. NaN never compares equal, so the next setWeights makes the edit
+    W1 = W2 = std::numeric_limits<double>::quiet_NaN ( );
+    IntParams.clear ( );
+    NumParams.clear ( );
+    checkData ( );
+}
+
+/*****************************************************************************************/
+bool CplexModel::rowsCoverModel ( )
+{
+    try{
+        std::unordered_set< IloInt > RowIds;
+        for ( IloInt r = 0; r < Rows.getSize ( ); ++r ) RowIds.insert ( Rows[r].getId ( ) );
+        for ( IloModel::Iterator it ( model ); it.ok ( ); ++it )
+        {
+            IloExtractable e = *it;
+            if ( e.isObjective ( ) || e.isVariable ( ) ) continue;
+            if ( isRelaxed ( ) && e.getId ( ) == Relaxation.getId ( ) ) continue;
+            if ( !e.isConstraint ( ) || RowIds.count ( e.getId ( ) ) == 0 ) return false;
+        }
+        return true;
+    }catch(IloException &ie){
+        std::cerr << "IloException in the rowsCoverModel of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::relax ( )
+{
+    try{
+        if ( isRelaxed ( ) ) return;
+        Relaxation = IloConversion ( env , AllVars , ILOFLOAT );
+        model.add ( Relaxation );
+    }catch(IloException &ie){
+        std::cerr << "IloException in the relax of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::unrelax ( )
+{
+    try{
+        if ( !isRelaxed ( ) ) return;
+        model.remove ( Relaxation );
+        Relaxation.end ( );
+        Relaxation = IloConversion ( );
+    }catch(IloException &ie){
+        std::cerr << "IloException in the unrelax of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::reset ( )
+{
+    try{
+        unrelax ( );
+        // End everything but the environment. Ending the model does not end the extractables in it
+        AllVars.endElements ( );
+        AllVars.end ( );
+        Rows.endElements ( );
+        Rows.end ( );
+        f1.end ( );
+        f2.end ( );
+        OBJ.end ( );
+        cplex.end ( );
+        model.end ( );
+
+        ObjVars.end ( );
+        LBBuffer.end ( );
+        UBBuffer.end ( );
+        WeightBuffer.end ( );
+
+        // Reinitialize as in the constructor
+        init ( );
+    }catch(IloException &ie){
+        std::cerr << "IloException in the reset of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
 /*****************************************************************************************/
 void CplexModel::buildBOKP( int n, int cap, const std::vector<int>& w, const std::vector<int>& p1, const std::vector<int> p2 )
 {
     try{
-        // Initialize IloExprs to hold objective and the constraint.
-        IloExpr Obj1 ( env ), Obj2 ( env ), cst ( env );
-        // Initialize binary variables
-        IloNumVarArray x = IloNumVarArray ( env, n , 0 , 1 , ILOBOOL );
+        // Build the model through the bulk functions. Note that the profits p1[i] and p2[i] are used as they are, so the tpm algorithm,
+        // which minimizes, finds the outcomes of least profit subject to the total weight being at least cap
+        IloInt first = addVariables ( n , 0 , 1 , ILOBOOL );
 
-        // Build  Objectives and constraints. Note that we use -p1[i] and -p2[i] as the tpm algorithm is implemented as a minimization problem
+        // Add the objective function and link the individual objective functions to f1 and f2
+        std::vector<double> c1 ( AllVars.getSize ( ) , 0.0 ), c2 ( AllVars.getSize ( ) , 0.0 );
         for ( int i=0; i<n; ++i )
         {
-            AllVars.add ( x[i] );
-            Obj1 += p1[i]*x[i];
-            Obj2 += p2[i]*x[i];
-            cst += w[i]*x[i];
+            c1[first+i] = p1[i];
+            c2[first+i] = p2[i];
         }
+        linkObjectives ( c1 , c2 );
 
-        // Add the objective function to the model
-        model.add ( OBJ );
+        // Add the knapsack constraint as a single CSR row
+        std::vector<int> start = { 0 , n }, ind ( n );
+        std::vector<double> val ( n );
+        for ( int i=0; i<n; ++i )
+        {
+            ind[i] = first + i;
+            val[i] = w[i];
+        }
+        addRowsCSR ( std::vector<double> ( 1 , cap ) , std::vector<double> ( 1 , IloInfinity ) , start , ind , val );
+    }catch(IloException &ie){
+        std::cerr << "IloException in the buildBOKP of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }catch ( std::exception &e){
+        std::cerr << "Exception in the buildBOKP of the CplexModelClass : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+IloInt CplexModel::addVariables ( IloInt n, double lb, double ub, IloNumVarType type )
+{
+    try{
+        IloInt first = AllVars.getSize ( );
+        // Create all the variables as one array and append the whole array at once
+        IloNumVarArray x = IloNumVarArray ( env, n , lb , ub , type );
+        AllVars.add ( x );
+        x.end ( ); // Ends the array only. The variables now live in AllVars
+        if ( Recording )
+        {
+            ModelData &d = record ( );
+            d.ColLB.insert ( d.ColLB.end ( ) , n , lb );
+            d.ColUB.insert ( d.ColUB.end ( ) , n , ub );
+            d.ColType.insert ( d.ColType.end ( ) , n , type );
+        }
+        return first;
+    }catch(IloException &ie){
+        std::cerr << "IloException in the addVariables of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
 
-        // Add the individual objective functions as constraints
-        model.add ( Obj1 == f1 );
-        model.add ( Obj2 == f2 );
+/*****************************************************************************************/
+void CplexModel::addRowsCSR ( const std::vector<double>& lb, const std::vector<double>& ub, const std::vector<int>& start,
+                              const std::vector<int>& ind, const std::vector<double>& val )
+{
+    try{
+        IloInt m = lb.size ( );
+        if ( ub.size ( ) != lb.size ( ) || start.size ( ) != lb.size ( ) + 1 || start[0] < 0 || ind.size ( ) < (size_t) start.back ( ) || val.size ( ) < (size_t) start.back ( ) )
+        {
+            throw std::runtime_error ( "Inconsistent sizes of the CSR arrays" );
+        }
+        // Check every index before anything is created, so a bad array leaves the model untouched
+        IloInt n = AllVars.getSize ( );
+        for ( IloInt r = 0; r < m; ++r )
+        {
+            if ( start[r+1] < start[r] ) throw std::runtime_error ( "The row start indices of the CSR arrays must be nondecreasing" );
+        }
+        for ( int k = start[0]; k < start.back ( ); ++k )
+        {
+            if ( ind[k] < 0 || ind[k] >= n ) throw std::runtime_error ( "Column index of the CSR arrays out of range" );
+        }
+        IloNumArray lbs ( env, m ), ubs ( env, m );
+        for ( IloInt r = 0; r < m; ++r )
+        {
+            lbs[r] = lb[r];
+            ubs[r] = ub[r];
+        }
+        IloRangeArray rows ( env, lbs , ubs );
 
-        // Add the knapsack constraint
-        model.add ( cst >= cap );
+        // Set the coefficients row by row. The arrays are reused so only the first (longest) rows allocate
+        IloNumVarArray rowVars ( env );
+        IloNumArray rowVals ( env );
+        for ( IloInt r = 0; r < m; ++r )
+        {
+            rowVars.clear ( );
+            rowVals.clear ( );
+            for ( int k = start[r]; k < start[r+1]; ++k )
+            {
+                rowVars.add ( AllVars[ind[k]] );
+                rowVals.add ( val[k] );
+            }
+            rows[r].setLinearCoefs ( rowVars , rowVals );
+        }
+        // The rows are complete before they are added, so they are extracted to cplex in one go
+        model.add ( rows );
+        Rows.add ( rows );
+        if ( Recording )
+        {   // Append the rows to the recorded CSR arrays
+            ModelData &d = record ( );
+            int offset = d.RowInd.size ( );
+            d.RowLB.insert ( d.RowLB.end ( ) , lb.begin ( ) , lb.end ( ) );
+            d.RowUB.insert ( d.RowUB.end ( ) , ub.begin ( ) , ub.end ( ) );
+            d.RowInd.insert ( d.RowInd.end ( ) , ind.begin ( ) + start[0] , ind.begin ( ) + start.back ( ) );
+            d.RowVal.insert ( d.RowVal.end ( ) , val.begin ( ) + start[0] , val.begin ( ) + start.back ( ) );
+            for ( IloInt r = 1; r <= m; ++r ) d.RowStart.push_back ( offset + start[r] - start[0] );
+        }
 
-        Obj1.end ( );
-        Obj2.end ( );
-        cst.end ( );
+        rowVars.end ( );
+        rowVals.end ( );
+        lbs.end ( );
+        ubs.end ( );
+        rows.end ( ); // Ends the array only. The ranges live on in the model
     }catch(IloException &ie){
-        std::cerr << "IloException in the buildSSCFLP of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        std::cerr << "IloException in the addRowsCSR of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }catch ( std::exception &e){
+        std::cerr << "Exception in the addRowsCSR of the CplexModelClass : " << e.what ( ) << std::endl;
         exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::addColumnsCSC ( const std::vector<double>& lb, const std::vector<double>& ub, const std::vector<int>& colStart,
+                                 const std::vector<int>& row, const std::vector<double>& val )
+{
+    try{
+        size_t m = lb.size ( );
+        if ( ub.size ( ) != m || colStart.size ( ) != (size_t) AllVars.getSize ( ) + 1 || colStart[0] != 0 ||
+             row.size ( ) < (size_t) colStart.back ( ) || val.size ( ) < (size_t) colStart.back ( ) )
+        {
+            throw std::runtime_error ( "Inconsistent sizes of the CSC arrays" );
+        }
+        // Check every index before the arrays are transposed, as the row indices are used to write into them
+        for ( size_t j = 0; j + 1 < colStart.size ( ); ++j )
+        {
+            if ( colStart[j+1] < colStart[j] ) throw std::runtime_error ( "The column start indices of the CSC arrays must be nondecreasing" );
+        }
+        for ( int k = 0; k < colStart.back ( ); ++k )
+        {
+            if ( row[k] < 0 || (size_t) row[k] >= m ) throw std::runtime_error ( "Row index of the CSC arrays out of range" );
+        }
+        // Transpose to CSR by counting the nonzeros in each row
+        std::vector<int> start ( m + 1 , 0 ), ind ( colStart.back ( ) );
+        std::vector<double> rowVal ( colStart.back ( ) );
+        for ( int k = 0; k < colStart.back ( ); ++k ) ++start[row[k]+1];
+        for ( size_t r = 0; r < m; ++r ) start[r+1] += start[r];
+        std::vector<int> next ( start.begin ( ) , start.end ( ) - 1 );
+        for ( size_t j = 0; j + 1 < colStart.size ( ); ++j )
+        {
+            for ( int k = colStart[j]; k < colStart[j+1]; ++k )
+            {
+                ind[next[row[k]]]       = j;
+                rowVal[next[row[k]]++]  = val[k];
+            }
+        }
+        addRowsCSR ( lb , ub , start , ind , rowVal );
     }catch ( std::exception &e){
-        std::cerr << "Exception in the buildSSCFLP of the CplexModelClass : " << e.what ( ) << std::endl;
+        std::cerr << "Exception in the addColumnsCSC of the CplexModelClass : " << e.what ( ) << std::endl;
         exit ( EXIT_FAILURE );
     }
 }
 
+/*****************************************************************************************/
+void CplexModel::linkObjectives ( const std::vector<double>& c1, const std::vector<double>& c2 )
+{
+    try{
+        IloInt n = AllVars.getSize ( );
+        if ( c1.size ( ) != (size_t) n || c2.size ( ) != (size_t) n )
+        {
+            throw std::runtime_error ( "The objective coefficient vectors must have size AllVars.getSize ( )" );
+        }
+        IloNumArray a1 ( env, n ), a2 ( env, n ), zero ( env, 2 );
+        for ( IloInt i = 0; i < n; ++i )
+        {
+            a1[i] = c1[i];
+            a2[i] = c2[i];
+        }
+        // Rows c1*x - f1 = 0 and c2*x - f2 = 0
+        IloRangeArray link ( env, zero , zero );
+        link[0].setLinearCoefs ( AllVars , a1 );
+        link[0].setLinearCoef ( f1 , -1.0 );
+        link[1].setLinearCoefs ( AllVars , a2 );
+        link[1].setLinearCoef ( f2 , -1.0 );
+
+        // Add the objective function and the linking rows
+        model.add ( OBJ );
+        model.add ( link );
+        Rows.add ( link );
+        if ( Recording )
+        {
+            ModelData &d = record ( );
+            d.C1 = c1;
+            d.C2 = c2;
+        }
+
+        a1.end ( );
+        a2.end ( );
+        zero.end ( );
+        link.end ( );
+    }catch(IloException &ie){
+        std::cerr << "IloException in the linkObjectives of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }catch ( std::exception &e){
+        std::cerr << "Exception in the linkObjectives of the CplexModelClass : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+ModelData& CplexModel::record ( )
+{
+    // Data handed out by getModelData ( ) must never change, so shared data is copied first
+    if ( !Data ) Data = std::make_shared< ModelData > ( );
+    else if ( Data.use_count ( ) > 1 ) Data = std::make_shared< ModelData > ( *Data );
+    return *Data;
+}
+
+/*****************************************************************************************/
+bool CplexModel::dataMatchesModel ( )
+{
+    try{
+        const ModelData &d = *Data;
+        IloInt n = AllVars.getSize ( );
+        if ( d.numberOfColumns ( ) != (size_t) n || !rowsCoverModel ( ) ) return false;
+
+        // Map the variables to their columns. f1 and f2 get the columns n and n+1
+        std::unordered_map< IloInt , IloInt > Column;
+        for ( IloInt j = 0; j < n; ++j )
+        {
+            if ( AllVars[j].getLB ( ) != d.ColLB[j] || AllVars[j].getUB ( ) != d.ColUB[j] || AllVars[j].getType ( ) != d.ColType[j] ) return false;
+            Column[AllVars[j].getId ( )] = j;
+        }
+        Column[f1.getId ( )] = n;
+        Column[f2.getId ( )] = n + 1;
+
+        // Each row of the model is subtracted from the recorded row in a dense vector, and the columns touched must come out zero.
+        // The rows defining f1 and f2 may be anywhere in Rows, the other rows are in the recorded order
+        std::vector< double > Dense ( n + 2 , 0.0 );
+        std::vector< IloInt > Touched;
+        bool Linked[2] = { false , false };
+        size_t r = 0;
+        for ( IloInt i = 0; i < Rows.getSize ( ); ++i )
+        {
+            Touched.clear ( );
+            IloInt objective = -1;
+            IloExpr expr = Rows[i].getExpr ( );
+            for ( IloExpr::LinearIterator it = expr.getLinearIterator ( ); it.ok ( ); ++it )
+            {
+                auto col = Column.find ( it.getVar ( ).getId ( ) );
+                if ( col == Column.end ( ) ) return false;
+                if ( col->second >= n ) objective = col->second - n;
+                Dense[col->second] -= it.getCoef ( );
+                Touched.push_back ( col->second );
+            }
+            if ( objective >= 0 )
+            {   // The row c*x - f = 0 defining f1 or f2
+                const std::vector< double > &c = ( objective == 0 ) ? d.C1 : d.C2;
+                if ( c.empty ( ) || Linked[objective] || Rows[i].getLB ( ) != 0.0 || Rows[i].getUB ( ) != 0.0 ) return false;
+                Linked[objective] = true;
+                for ( IloInt j = 0; j < n; ++j )
+                {
+                    if ( c[j] != 0.0 ) Touched.push_back ( j );
+                    Dense[j] += c[j];
+                }
+                Dense[n + objective] -= 1.0;
+            }
+            else
+            {
+                if ( r >= d.numberOfRows ( ) || Rows[i].getLB ( ) != d.RowLB[r] || Rows[i].getUB ( ) != d.RowUB[r] ) return false;
+                for ( int k = d.RowStart[r]; k < d.RowStart[r+1]; ++k )
+                {
+                    Dense[d.RowInd[k]] += d.RowVal[k];
+                    Touched.push_back ( d.RowInd[k] );
+                }
+                ++r;
+            }
+            bool equal = true;
+            for ( auto j = Touched.begin ( ); j != Touched.end ( ); ++j )
+            {
+                if ( std::fabs ( Dense[*j] ) > 1.0e-9 ) equal = false;
+                Dense[*j] = 0.0;
+            }
+            if ( !equal ) return false;
+        }
+        return r == d.numberOfRows ( ) && Linked[0] == !d.C1.empty ( ) && Linked[1] == !d.C2.empty ( );
+    }catch(IloException &ie){
+        std::cerr << "IloException in the dataMatchesModel of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/*****************************************************************************************/
+void CplexModel::checkData ( )
+{
+    if ( Data && !dataMatchesModel ( ) )
+    {   // Models built from the data would solve another problem. Later bulk building calls cannot repair it, so nothing more is recorded
+        Data.reset ( );
+        Recording = false;
+    }
+}
+
+/*****************************************************************************************/
+std::shared_ptr< const ModelData > CplexModel::getModelData ( )
+{
+    checkData ( );
+    return Data;
+}
+
+/*****************************************************************************************/
+void CplexModel::build ( const std::shared_ptr< const ModelData > &data )
+{
+    try{
+        if ( !data ) throw std::runtime_error ( "No ModelData to build from" );
+        if ( AllVars.getSize ( ) != 0 || Rows.getSize ( ) != 0 ) throw std::runtime_error ( "A model can only be build from a ModelData when it is empty" );
+        size_t n = data->numberOfColumns ( );
+        Recording = false;
+
+        // Create the variables as one array per run of variables of the same type
+        IloNumArray lbs ( env ), ubs ( env );
+        for ( size_t first = 0, last = 0; first < n; first = last )
+        {
+            lbs.clear ( );
+            ubs.clear ( );
+            for ( last = first; last < n && data->ColType[last] == data->ColType[first]; ++last )
+            {
+                lbs.add ( data->ColLB[last] );
+                ubs.add ( data->ColUB[last] );
+            }
+            IloNumVarArray x ( env , lbs , ubs , data->ColType[first] );
+            AllVars.add ( x );
+            x.end ( ); // Ends the array only. The variables now live in AllVars
+        }
+        lbs.end ( );
+        ubs.end ( );
+
+        if ( !data->C1.empty ( ) ) linkObjectives ( data->C1 , data->C2 );
+        if ( data->numberOfRows ( ) > 0 ) addRowsCSR ( data->RowLB , data->RowUB , data->RowStart , data->RowInd , data->RowVal );
+
+        // The model now holds exactly the problem in data. It is shared, and record ( ) copies it before any change, so it stays constant
+        Data = std::const_pointer_cast< ModelData > ( data );
+        Recording = true;
+    }catch(IloException &ie){
+        std::cerr << "IloException in the build of the CplexModelClass : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }catch ( std::exception &e){
+        std::cerr << "Exception in the build of the CplexModelClass : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
@@ -5,9 +5,50 @@
 #include<iostream>
 #include<ilcplex/ilocplex.h>
 #include<string>
+#include<stdexcept>
+#include<map>
+#include<memory>
+#include"ModelData.h"
 typedef IloArray<IloNumVarArray>    IloVarMatrix;
 
 class CplexModel{
+    private:
+        /**
+         * @name Cached model state
+         * The values last given to f1, f2, OBJ and cplex through the fast modification functions below. Used to skip edits which change nothing.
+         */
+        ///@{
+            double F1LB, F1UB, F2LB, F2UB;  //!< Bounds on f1 and f2
+            double W1, W2;                  //!< Coefficients of f1 and f2 in OBJ
+            IloNumVarArray ObjVars;         //!< The array { f1 , f2 }, so both can be changed in a single call
+            IloNumArray LBBuffer, UBBuffer, WeightBuffer; //!< Buffers reused when changing both objectives at once
+            std::map< IloCplex::IntParam , IloInt > IntParams;  //!< Integer parameters set through setParameter
+            std::map< IloCplex::NumParam , double > NumParams;  //!< Numerical parameters set through setParameter
+        ///@}
+
+        std::shared_ptr< ModelData > Data;  //!< The base problem as recorded by the bulk building functions. Null until the first of them is called
+        bool Recording;                     //!< False while the model is build from a ModelData, so the data is not recorded a second time, and after the data was found not to match the model
+
+        /*!
+         * Returns the ModelData the bulk building functions append to. Data handed out by getModelData ( ) is shared, and is copied before it is changed
+         */
+        ModelData& record ( );
+
+        /*!
+         * Returns true if Data still describes the model: Rows covers the model, and the variables, rows and objective coefficients are those recorded
+         */
+        bool dataMatchesModel ( );
+
+        /*!
+         * Releases Data and stops recording if the model was changed other than through the bulk building functions
+         */
+        void checkData ( );
+
+        /*!
+         * Creates f1, f2, OBJ, AllVars and the buffers of the fast modification functions on env. Used by the constructor and by reset ( )
+         */
+        void init ( );
+
     public:
         IloEnv env;             //!< IloEnv used to build the model on
         IloModel model;         //!< IloModel used to hold the model that should be solved
@@ -16,6 +57,8 @@ class CplexModel{
         IloNumVar f2;           //!< Variable used to hold the second objective
         IloObjective OBJ;       //!< IloObjective used to hold the objective f1 + f2. It is needed so that objective function coefficients can later be changed
         IloNumVarArray AllVars; //!< Array of variables. Used to hold all the variables so that no-good inequalities can be generated in the tpm algorithm
+        IloRangeArray Rows;     //!< Array of all constraints added through the bulk building functions, so they can be ended by reset ( )
+        IloConversion Relaxation; //!< Conversion of AllVars to continuous variables. Only in the model between calls to relax ( ) and unrelax ( )
 
         /*! \brief Constructor of the CplexModel class
          *
@@ -23,12 +66,112 @@ class CplexModel{
          */
         CplexModel();
 
+        /*! \brief Constructs a model from the data of another
+         *
+         * Builds the problem held by data (see build). The arrays of data are shared, not copied.
+         * \param data constant reference to a shared pointer to a constant ModelData. Usually obtained from getModelData ( ) of another model
+         */
+        explicit CplexModel ( const std::shared_ptr< const ModelData > &data );
+
         /*! \brief Destructor of the CplexModel class.
          *
          * Destructor deallocating all memory allocated in the CplexModel object's life time
          */
         ~CplexModel();
 
+        /**
+         * @name Fast model modification
+         * Functions used by tpm to change the bounds on f1 and f2, the weights in OBJ and the cplex parameters between subproblems.
+         * Edits which change nothing are skipped, and when both objectives change, the change is made in one call on the array { f1 , f2 },
+         * so it is synchronised with the extracted problem once instead of once per variable.
+         * \note If f1, f2, OBJ or the parameters are changed directly, synchronize ( ) must be called before the fast functions are used again.
+         */
+        ///@{
+
+        /*! \brief Sets the bounds on both objectives
+         * \param lb1 double. Lower bound on f1
+         * \param ub1 double. Upper bound on f1
+         * \param lb2 double. Lower bound on f2
+         * \param ub2 double. Upper bound on f2
+         */
+        void setObjectiveBounds ( double lb1, double ub1, double lb2, double ub2 );
+
+        /*!
+         * Sets the upper bound on f1, keeping its lower bound
+         */
+        void setF1UB ( double ub ) { setObjectiveBounds ( F1LB , ub , F2LB , F2UB ); }
+
+        /*!
+         * Sets the upper bound on f2, keeping its lower bound
+         */
+        void setF2UB ( double ub ) { setObjectiveBounds ( F1LB , F1UB , F2LB , ub ); }
+
+        /*! \brief Sets the coefficients of f1 and f2 in OBJ
+         * \param w1 double. Coefficient of f1
+         * \param w2 double. Coefficient of f2
+         */
+        void setWeights ( double w1, double w2 );
+
+        /*! \brief Returns the coefficients of f1 and f2 in OBJ
+         *
+         * Uses the cached values when they are known, and reads them from OBJ otherwise (after synchronize).
+         * \param w1 reference to a double. Coefficient of f1 on output
+         * \param w2 reference to a double. Coefficient of f2 on output
+         */
+        void getWeights ( double &w1, double &w2 );
+
+        /*!
+         * Sets an integer cplex parameter, unless it already has the value
+         */
+        void setParameter ( IloCplex::IntParam param, IloInt value );
+
+        /*!
+         * Sets a numerical cplex parameter, unless it already has the value
+         */
+        void setParameter ( IloCplex::NumParam param, double value );
+
+        /*! \brief Synchronises the cached state with the model
+         *
+         * Reads the bounds on f1 and f2 from the model, and forgets the weights and parameters, so the next call of each fast function makes the edit.
+         * The recorded ModelData is released if the model no longer matches it (see getModelData).
+         */
+        void synchronize ( );
+        ///@}
+
+        /*! \brief Relaxes the integrality of all decision variables
+         *
+         * Adds an IloConversion of AllVars to ILOFLOAT to the model, so cplex solves the LP relaxation until unrelax ( ) is called.
+         * Calling relax ( ) on a model which is already relaxed has no effect.
+         */
+        void relax ( );
+
+        /*!
+         * Removes the conversion added by relax ( ), so cplex solves the original problem again
+         */
+        void unrelax ( );
+
+        /*!
+         * Returns true if the model is currently relaxed
+         */
+        bool isRelaxed ( ) const { return Relaxation.getImpl ( ) != nullptr; }
+
+        /*! \brief Checks that Rows holds every constraint of the model
+         *
+         * Walks the extractables of model. Apart from OBJ, variables and the conversion added by relax ( ), every one of them must be a constraint in Rows.
+         * Functions which read the problem from Rows (such as the test for total unimodularity) are only correct if this holds.
+         * \return bool. False if a constraint, conversion or other extractable was added to model directly
+         */
+        bool rowsCoverModel ( );
+
+        /*! \brief Clears the model, but keeps the environment
+         *
+         * Ends all variables, constraints and the IloCplex object, and reinitializes model, cplex, f1, f2, OBJ and AllVars
+         * exactly as the constructor does. The IloEnv is kept, so a new instance can be build without paying for a new environment.
+         * The recorded ModelData is released. Models built from it are not affected.
+         * \note Constraints added directly to model (and not through the bulk building functions) are not ended, and stay in the environment until it is ended.
+         */
+        void reset ( );
+
         /**
          * Implementing an instance of the bi-objective binary knapsack problem
          * \param n integer. Number of items in the KP problem
@@ -40,6 +183,77 @@ class CplexModel{
          */
         void buildBOKP( int n, int cap, const std::vector<int>& w, const std::vector<int>& p1, const std::vector<int> p2 );
 
+        /**
+         * @name Bulk model building
+         * Functions building the model from coefficient arrays in one call each instead of one operator+= per coefficient.
+         * Large models should be build using these, as Concert allocates a new expression node for every += on an IloExpr.
+         */
+        ///@{
+
+        /*! \brief Adds a batch of decision variables to the model
+         *
+         * Creates n variables with identical bounds and type in one call and appends them to AllVars.
+         * \param n integer. Number of variables to create
+         * \param lb double. Lower bound of the variables
+         * \param ub double. Upper bound of the variables
+         * \param type IloNumVarType. Type of the variables (ILOBOOL, ILOINT or ILOFLOAT)
+         * \return IloInt. The index in AllVars of the first variable created
+         */
+        IloInt addVariables ( IloInt n, double lb, double ub, IloNumVarType type );
+
+        /*! \brief Adds a batch of constraints given in compressed sparse row (CSR) format
+         *
+         * Adds the rows lb[r] <= sum_k val[k]*AllVars[ind[k]] <= ub[r], where k runs from start[r] to start[r+1]-1.
+         * All rows are created as one IloRangeArray and added to the model in a single call.
+         * \param lb constant reference to a vector of doubles. Lower bound of each row. Use -IloInfinity for <= rows
+         * \param ub constant reference to a vector of doubles. Upper bound of each row. Use IloInfinity for >= rows
+         * \param start constant reference to a vector of integers. Row start indices. Must have size lb.size()+1
+         * \param ind constant reference to a vector of integers. Column indices (into AllVars) of the nonzeros
+         * \param val constant reference to a vector of doubles. Values of the nonzeros
+         * \note ind and val must have size start.back()
+         */
+        void addRowsCSR ( const std::vector<double>& lb, const std::vector<double>& ub, const std::vector<int>& start,
+                          const std::vector<int>& ind, const std::vector<double>& val );
+
+        /*! \brief Adds a batch of constraints given column by column
+         *
+         * Same as addRowsCSR, but the nonzeros are given in compressed sparse column format, which is how
+         * set packing and covering data is usually stored. Column j holds the nonzeros colStart[j] to colStart[j+1]-1
+         * and colStart must have size AllVars.getSize()+1.
+         */
+        void addColumnsCSC ( const std::vector<double>& lb, const std::vector<double>& ub, const std::vector<int>& colStart,
+                             const std::vector<int>& row, const std::vector<double>& val );
+
+        /*! \brief Links the two objective functions to f1 and f2
+         *
+         * Adds the objective function OBJ and the two rows f1 = c1*AllVars and f2 = c2*AllVars to the model in one step.
+         * \param c1 constant reference to a vector of doubles. Coefficients of the first objective. Must have size AllVars.getSize()
+         * \param c2 constant reference to a vector of doubles. Coefficients of the second objective. Must have size AllVars.getSize()
+         */
+        void linkObjectives ( const std::vector<double>& c1, const std::vector<double>& c2 );
+
+        /*! \brief Returns the base problem as recorded by the bulk building functions
+         *
+         * The data is immutable. If the model is changed through the bulk building functions later on, the model records into a copy, so
+         * models built from the returned data are not affected.
+         * The data is compared with the model first. If a variable or constraint was added directly to model, or a bound or coefficient was changed
+         * other than through the bulk building functions, the data is released and nothing more is recorded until the model is reset.
+         * \return shared pointer to a constant ModelData. Null if no bulk building function has been called since the model was constructed or reset, or if the model no longer matches the data
+         */
+        std::shared_ptr< const ModelData > getModelData ( );
+
+        /*! \brief Builds the problem held by a ModelData in an empty model
+         *
+         * Creates the variables (one IloNumVarArray per run of variables of the same type), links the objectives and adds the rows through addRowsCSR.
+         * The model then shares data instead of recording its own copy. Used to give each worker thread its own model of the same problem without
+         * calling user code, as IloEnv and IloCplex cannot be shared between threads.
+         * \param data constant reference to a shared pointer to a constant ModelData
+         * \note The model must be empty, that is newly constructed or reset
+         */
+        void build ( const std::shared_ptr< const ModelData > &data );
+        ///@}
+
+
 };
 
 #endif // CPLEXMODEL_H_INCLUDED
@@ -0,0 +1,134 @@
+#include"LineChannel.h"
+
+#include<stdexcept>
+#include<cstring>
+#include<sys/types.h>
+#include<sys/socket.h>
+#include<netdb.h>
+#include<netinet/in.h>
+#include<netinet/tcp.h>
+#include<arpa/inet.h>
+#include<unistd.h>
+
+/********************************************************************************************/
+LineChannel::LineChannel ( ): FD ( -1 ) {}
+
+/********************************************************************************************/
+LineChannel::LineChannel ( int fd ): FD ( fd )
+{
+    int one = 1;
+    setsockopt ( FD , IPPROTO_TCP , TCP_NODELAY , &one , sizeof ( one ) ); // Messages are small, and should not wait for more data
+}
+
+/********************************************************************************************/
+LineChannel::~LineChannel ( )
+{
+    close ( );
+}
+
+/********************************************************************************************/
+int LineChannel::listenOn ( int port, const std::string &address )
+{
+    sockaddr_in local;
+    std::memset ( &local , 0 , sizeof ( local ) );
+    local.sin_family    = AF_INET;
+    local.sin_port      = htons ( port );
+    if ( inet_pton ( AF_INET , address.c_str ( ) , &local.sin_addr ) != 1 ) throw std::runtime_error ( "Not an IPv4 address: " + address );
+    int fd = socket ( AF_INET , SOCK_STREAM , 0 );
+    if ( fd < 0 ) throw std::runtime_error ( "Could not create a socket" );
+    int one = 1;
+    setsockopt ( fd , SOL_SOCKET , SO_REUSEADDR , &one , sizeof ( one ) );
+    if ( bind ( fd , (sockaddr*) &local , sizeof ( local ) ) < 0 || listen ( fd , 64 ) < 0 )
+    {
+        ::close ( fd );
+        throw std::runtime_error ( "Could not listen on " + address + ":" + std::to_string ( port ) );
+    }
+    return fd;
+}
+
+/********************************************************************************************/
+int LineChannel::acceptOn ( int listenFD )
+{
+    return accept ( listenFD , nullptr , nullptr );
+}
+
+/********************************************************************************************/
+void LineChannel::connectTo ( const std::string &host, int port )
+{
+    close ( );
+    addrinfo hints, *result = nullptr;
+    std::memset ( &hints , 0 , sizeof ( hints ) );
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if ( getaddrinfo ( host.c_str ( ) , std::to_string ( port ).c_str ( ) , &hints , &result ) != 0 )
+        throw std::runtime_error ( "Could not resolve the host " + host );
+    for ( addrinfo *it = result; it != nullptr; it = it->ai_next )
+    {
+        int fd = socket ( it->ai_family , it->ai_socktype , it->ai_protocol );
+        if ( fd < 0 ) continue;
+        if ( connect ( fd , it->ai_addr , it->ai_addrlen ) == 0 )
+        {
+            FD = fd;
+            break;
+        }
+        ::close ( fd );
+    }
+    freeaddrinfo ( result );
+    if ( FD < 0 ) throw std::runtime_error ( "Could not connect to " + host + ":" + std::to_string ( port ) );
+    int one = 1;
+    setsockopt ( FD , IPPROTO_TCP , TCP_NODELAY , &one , sizeof ( one ) );
+}
+
+/********************************************************************************************/
+void LineChannel::close ( )
+{
+    if ( FD >= 0 ) ::close ( FD );
+    FD = -1;
+    Buffer.clear ( );
+}
+
+/********************************************************************************************/
+bool LineChannel::sendLine ( const std::string &line )
+{
+    if ( FD < 0 ) return false;
+    std::string message = line + "\n";
+    size_t sent = 0;
+    while ( sent < message.size ( ) )
+    {
+        ssize_t n = send ( FD , message.data ( ) + sent , message.size ( ) - sent , MSG_NOSIGNAL );
+        if ( n <= 0 ) return false;
+        sent += n;
+    }
+    return true;
+}
+
+/********************************************************************************************/
+bool LineChannel::receive ( )
+{
+    if ( FD < 0 ) return false;
+    char chunk[4096];
+    ssize_t n = recv ( FD , chunk , sizeof ( chunk ) , 0 );
+    if ( n <= 0 ) return false;
+    Buffer.append ( chunk , n );
+    return true;
+}
+
+/********************************************************************************************/
+bool LineChannel::nextLine ( std::string &line )
+{
+    size_t end = Buffer.find ( '\n' );
+    if ( end == std::string::npos ) return false;
+    line = Buffer.substr ( 0 , end );
+    Buffer.erase ( 0 , end + 1 );
+    return true;
+}
+
+/********************************************************************************************/
+bool LineChannel::readLine ( std::string &line )
+{
+    while ( !nextLine ( line ) )
+    {
+        if ( !receive ( ) ) return false;
+    }
+    return true;
+}
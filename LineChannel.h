@@ -0,0 +1,93 @@
+#ifndef LINECHANNEL_H_INCLUDED
+#define LINECHANNEL_H_INCLUDED
+
+/**
+ * Class wrapping a TCP socket which sends and receives lines of text. Used by the coordinator and the workers when
+ * phase two is distributed over several processes. Errors when opening a connection are reported by throwing std::runtime_error.
+ */
+
+//! C++ includes
+#include<string>
+
+class LineChannel{
+    private:
+        int FD;             //!< File descriptor of the socket. Negative if the channel is closed
+        std::string Buffer; //!< Received data not yet returned as lines
+
+    public:
+        /*!
+         * Default constructor. The channel is closed
+         */
+        LineChannel ( );
+
+        /*!
+         * Constructor taking an open socket
+         */
+        explicit LineChannel ( int fd );
+
+        /*!
+         * Destructor. Closes the socket
+         */
+        ~LineChannel ( );
+
+        LineChannel ( const LineChannel& ) = delete;
+        LineChannel& operator= ( const LineChannel& ) = delete;
+
+        /*! \brief Opens a socket listening for connections
+         * \param port integer. The port to listen on
+         * \param address string. IPv4 address of the interface to listen on. Default is the loopback interface, so only local processes can connect.
+         * Use "0.0.0.0" to listen on all interfaces
+         * \return int. The file descriptor of the listening socket
+         */
+        static int listenOn ( int port, const std::string &address = "127.0.0.1" );
+
+        /*! \brief Accepts a connection on a listening socket
+         * \param listenFD integer. File descriptor returned by listenOn
+         * \return int. The file descriptor of the connection. Negative if no connection could be accepted
+         */
+        static int acceptOn ( int listenFD );
+
+        /*! \brief Connects to a listening socket
+         * \param host string. Name or address of the host
+         * \param port integer. The port to connect to
+         */
+        void connectTo ( const std::string &host, int port );
+
+        /*!
+         * Closes the socket
+         */
+        void close ( );
+
+        /*!
+         * Returns the file descriptor of the socket, for use with poll
+         */
+        int getFD ( ) const { return FD; }
+
+        /*!
+         * Returns true if the socket is open
+         */
+        bool isOpen ( ) const { return FD >= 0; }
+
+        /*! \brief Sends a line of text. A newline is appended
+         * \return bool. False if the connection is broken
+         */
+        bool sendLine ( const std::string &line );
+
+        /*! \brief Reads the data available on the socket, waiting until some arrives
+         * \return bool. False if the connection is closed or broken
+         */
+        bool receive ( );
+
+        /*! \brief Returns the next complete line received, if any
+         * \param line reference to a string. Holds the line without the newline on return
+         * \return bool. True if a line was returned
+         */
+        bool nextLine ( std::string &line );
+
+        /*! \brief Returns the next line, waiting until it arrives
+         * \return bool. False if the connection was closed before a line arrived
+         */
+        bool readLine ( std::string &line );
+};
+
+#endif // LINECHANNEL_H_INCLUDED
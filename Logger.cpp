@@ -0,0 +1,126 @@
+#include"Logger.h"
+
+#include<iostream>
+#include<cstring>
+#include<cstdio>
+#include<algorithm>
+
+const size_t Logger::MaxMessage;
+
+/********************************************************************************************/
+Logger::Logger ( size_t capacity ):
+    Mask ( 0 ),
+    EnqueuePos ( 0 ),
+    DequeuePos ( 0 ),
+    WrittenPos ( 0 ),
+    Dropped ( 0 ),
+    Level ( LOG_INFO ),
+    Stream ( &std::cout ),
+    Stop ( false ),
+    Start ( std::chrono::steady_clock::now ( ) )
+{
+    size_t size = 2;
+    while ( size < capacity ) size *= 2;
+    Mask = size - 1;
+    Ring.reset ( new SLOT[size] );
+    for ( size_t i = 0; i < size; ++i ) Ring[i].Sequence.store ( i , std::memory_order_relaxed );
+    Writer = std::thread ( &Logger::WriterLoop , this );
+}
+
+/********************************************************************************************/
+Logger::~Logger ( )
+{
+    Stop.store ( true );
+    if ( Writer.joinable ( ) ) Writer.join ( );
+}
+
+/********************************************************************************************/
+Logger& Logger::global ( )
+{
+    static Logger theLogger ( 4096 );
+    return theLogger;
+}
+
+/********************************************************************************************/
+void Logger::setStream ( std::ostream *stream )
+{
+    flush ( );
+    Stream.store ( stream );
+}
+
+/********************************************************************************************/
+void Logger::write ( int level, const std::string &message )
+{
+    // Bounded multi producer queue by D. Vyukov. A slot is free for position pos when its sequence equals pos
+    size_t pos = EnqueuePos.load ( std::memory_order_relaxed );
+    SLOT *slot;
+    while ( true )
+    {
+        slot = &Ring[pos & Mask];
+        size_t seq = slot->Sequence.load ( std::memory_order_acquire );
+        long long dif = (long long) seq - (long long) pos;
+        if ( dif == 0 )
+        {
+            if ( EnqueuePos.compare_exchange_weak ( pos , pos + 1 , std::memory_order_relaxed ) ) break;
+        }
+        else if ( dif < 0 )
+        {   // The buffer is full. Drop the message rather than wait
+            Dropped.fetch_add ( 1 , std::memory_order_relaxed );
+            return;
+        }
+        else pos = EnqueuePos.load ( std::memory_order_relaxed );
+    }
+    slot->Level     = level;
+    slot->Time      = std::chrono::duration< double > ( std::chrono::steady_clock::now ( ) - Start ).count ( );
+    slot->Length    = std::min ( message.size ( ) , MaxMessage );
+    std::memcpy ( slot->Text , message.data ( ) , slot->Length );
+    slot->Sequence.store ( pos + 1 , std::memory_order_release );
+}
+
+/********************************************************************************************/
+void Logger::flush ( )
+{
+    size_t target = EnqueuePos.load ( );
+    while ( WrittenPos.load ( ) < target && Writer.joinable ( ) ) std::this_thread::sleep_for ( std::chrono::milliseconds ( 1 ) );
+}
+
+/********************************************************************************************/
+void Logger::WriterLoop ( )
+{
+    static const char *Names[] = { "OFF" , "ERROR" , "WARN" , "INFO" , "PROG" , "DEBUG" };
+    char prefix[32];
+    unsigned long ReportedDropped = 0;
+    while ( true )
+    {
+        bool stop = Stop.load ( );
+        std::ostream &out = *Stream.load ( );
+        size_t written = 0;
+        // Write every message ready in the buffer
+        while ( true )
+        {
+            size_t pos = DequeuePos.load ( std::memory_order_relaxed );
+            SLOT &slot = Ring[pos & Mask];
+            if ( slot.Sequence.load ( std::memory_order_acquire ) != pos + 1 ) break; // Empty
+            DequeuePos.store ( pos + 1 , std::memory_order_relaxed ); // Single consumer
+            int level = ( slot.Level >= LOG_OFF && slot.Level <= LOG_DEBUG ) ? slot.Level : LOG_DEBUG;
+            std::snprintf ( prefix , sizeof ( prefix ) , "[%10.3f] %-5s " , slot.Time , Names[level] );
+            out << prefix;
+            out.write ( slot.Text , slot.Length );
+            out << '\n';
+            slot.Sequence.store ( pos + Mask + 1 , std::memory_order_release );
+            ++written;
+        }
+        unsigned long dropped = Dropped.load ( std::memory_order_relaxed );
+        if ( dropped > ReportedDropped )
+        {
+            out << "[   logger] WARN  dropped messages=" << dropped - ReportedDropped << '\n';
+            ReportedDropped = dropped;
+            ++written;
+        }
+        // The stream is flushed only when the buffer is empty, never for each message
+        if ( written > 0 ) out.flush ( );
+        WrittenPos.store ( DequeuePos.load ( std::memory_order_relaxed ) , std::memory_order_release );
+        if ( stop ) return;
+        if ( written == 0 ) std::this_thread::sleep_for ( std::chrono::milliseconds ( 5 ) );
+    }
+}
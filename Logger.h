@@ -0,0 +1,180 @@
+#ifndef LOGGER_H_INCLUDED
+#define LOGGER_H_INCLUDED
+
+/**
+ * Class implementing a levelled, asynchronous logger. Messages are put in a bounded lock free ring buffer by the threads logging them,
+ * and written by a background thread, which flushes the stream only when the buffer is empty. If the buffer is full, the message is dropped
+ * and counted, so logging never blocks the algorithm. A single, process wide object is reached through Logger::global ( ).
+ *
+ * Messages are logged through the TPM_LOG macro, which checks the level before the message is built, so a disabled level costs a single
+ * atomic load. Each line holds the time since the logger started, the level and the message, which is written as an event name followed by key=value pairs.
+ */
+
+//! C++ includes
+#include<atomic>
+#include<memory>
+#include<string>
+#include<sstream>
+#include<ostream>
+#include<thread>
+#include<chrono>
+
+enum LogLevel{
+    LOG_OFF         = 0,    //!< Nothing is logged
+    LOG_ERROR       = 1,    //!< Errors
+    LOG_WARNING     = 2,    //!< Time limits reached and other events which make the result incomplete
+    LOG_INFO        = 3,    //!< Phase times and summaries. The default level
+    LOG_PROGRESS    = 4,    //!< Progress of phase two, rate limited
+    LOG_DEBUG       = 5     //!< Every event
+};
+
+class Logger{
+    private:
+        static const size_t MaxMessage = 240;   //!< Longest message stored. Longer messages are truncated
+        struct SLOT{
+            std::atomic< size_t > Sequence; //!< Position in the ring the slot is ready for
+            int Level;                      //!< Level of the message
+            double Time;                    //!< Seconds since the logger started
+            size_t Length;                  //!< Length of the message
+            char Text[MaxMessage];          //!< The message
+        }; //!< Struct holding a message in the ring buffer
+
+        std::unique_ptr< SLOT[] > Ring;     //!< The ring buffer
+        size_t Mask;                        //!< Capacity of the ring buffer minus one. The capacity is a power of two
+        std::atomic< size_t > EnqueuePos;   //!< Next position to write to
+        std::atomic< size_t > DequeuePos;   //!< Next position to read from
+        std::atomic< size_t > WrittenPos;   //!< All messages before this position are written and flushed
+        std::atomic< unsigned long > Dropped; //!< Number of messages dropped because the buffer was full
+        std::atomic< int > Level;           //!< Messages with a level above this are not logged
+        std::atomic< std::ostream* > Stream;//!< The stream written to. Default is std::cout
+        std::atomic< bool > Stop;           //!< Tells the writer thread to write the remaining messages and return
+        std::chrono::steady_clock::time_point Start; //!< Time the logger started
+        std::thread Writer;                 //!< The background writer thread
+
+        /*!
+         * Constructor. Starts the writer thread
+         * \param capacity size_t. Capacity of the ring buffer. Rounded up to a power of two
+         */
+        explicit Logger ( size_t capacity );
+
+        /*!
+         * Main loop of the writer thread
+         */
+        void WriterLoop ( );
+
+    public:
+        /*!
+         * Destructor. Writes the remaining messages and stops the writer thread
+         */
+        ~Logger ( );
+
+        /*!
+         * Returns the process wide logger
+         */
+        static Logger& global ( );
+
+        /*!
+         * Returns true if messages of the level are logged
+         */
+        inline
+        bool isEnabled ( int level ) const { return level <= Level.load ( std::memory_order_relaxed ); }
+
+        /*! \brief Sets the level
+         * \param level integer. Messages with a level above this are not logged. Default is LOG_INFO
+         */
+        void setLevel ( int level ) { Level.store ( level , std::memory_order_relaxed ); }
+
+        /*!
+         * Returns the level
+         */
+        int getLevel ( ) const { return Level.load ( std::memory_order_relaxed ); }
+
+        /*! \brief Sets the stream written to
+         * \param stream pointer to an ostream. Must stay valid while messages are written. Default is std::cout
+         */
+        void setStream ( std::ostream *stream );
+
+        /*! \brief Puts a message in the buffer. Never blocks
+         * \param level integer. The level of the message
+         * \param message constant reference to a string. The message
+         */
+        void write ( int level, const std::string &message );
+
+        /*!
+         * Waits until all messages logged so far are written and the stream is flushed
+         */
+        void flush ( );
+
+        /*!
+         * Returns the number of messages dropped because the buffer was full
+         */
+        unsigned long getNumberOfDropped ( ) const { return Dropped.load ( ); }
+};
+
+/**
+ * Class limiting how often a progress message is logged. Messages not logged are counted, and the count is added to the next message logged.
+ */
+class LogRate{
+    private:
+        std::atomic< long long > Next;          //!< Time in nanoseconds before which no message is logged
+        std::atomic< unsigned long > Suppressed;//!< Number of messages not logged since the last one
+        long long Interval;                     //!< Minimum time between two messages in nanoseconds
+
+    public:
+        /*! \brief Constructor
+         * \param seconds double. Minimum time between two messages. Default is one second
+         */
+        explicit LogRate ( double seconds = 1.0 ): Next ( 0 ), Suppressed ( 0 ), Interval ( (long long) ( seconds * 1e9 ) ) {}
+
+        /*! \brief Sets the minimum time between two messages
+         * \param seconds double. Zero logs every message
+         */
+        void setInterval ( double seconds ) { Interval = (long long) ( seconds * 1e9 ); }
+
+        /*!
+         * Returns true if a message may be logged now. Otherwise the message is counted as suppressed
+         */
+        bool allow ( )
+        {
+            long long now = std::chrono::duration_cast< std::chrono::nanoseconds > ( std::chrono::steady_clock::now ( ).time_since_epoch ( ) ).count ( );
+            long long next = Next.load ( std::memory_order_relaxed );
+            if ( now >= next && Next.compare_exchange_strong ( next , now + Interval ) ) return true;
+            Suppressed.fetch_add ( 1 , std::memory_order_relaxed );
+            return false;
+        }
+
+        /*!
+         * Returns the number of messages suppressed since the last call, and resets it
+         */
+        unsigned long takeSuppressed ( ) { return Suppressed.exchange ( 0 ); }
+};
+
+/*!
+ * Logs a message built by streaming expr, if the level is enabled. Example: TPM_LOG ( LOG_INFO , "phase_one time=" << t );
+ */
+#define TPM_LOG( level , expr )                                                         \
+    do {                                                                                \
+        if ( Logger::global ( ).isEnabled ( level ) )                                   \
+        {                                                                               \
+            std::ostringstream TPM_LOG_STREAM;                                          \
+            TPM_LOG_STREAM << expr;                                                     \
+            Logger::global ( ).write ( level , TPM_LOG_STREAM.str ( ) );                \
+        }                                                                               \
+    } while ( 0 )
+
+/*!
+ * Logs a progress message, if LOG_PROGRESS is enabled and rate allows it. The number of messages suppressed by rate is added as suppressed=n
+ */
+#define TPM_LOG_PROGRESS( rate , expr )                                                 \
+    do {                                                                                \
+        if ( Logger::global ( ).isEnabled ( LOG_PROGRESS ) && ( rate ).allow ( ) )      \
+        {                                                                               \
+            std::ostringstream TPM_LOG_STREAM;                                          \
+            TPM_LOG_STREAM << expr;                                                     \
+            unsigned long TPM_LOG_SUPPRESSED = ( rate ).takeSuppressed ( );             \
+            if ( TPM_LOG_SUPPRESSED > 0 ) TPM_LOG_STREAM << " suppressed=" << TPM_LOG_SUPPRESSED; \
+            Logger::global ( ).write ( LOG_PROGRESS , TPM_LOG_STREAM.str ( ) );         \
+        }                                                                               \
+    } while ( 0 )
+
+#endif // LOGGER_H_INCLUDED
@@ -0,0 +1,38 @@
+#ifndef MODELDATA_H_INCLUDED
+#define MODELDATA_H_INCLUDED
+
+/**
+ * Struct holding the base problem as plain arrays: the variables with their bounds and types, the constraints in compressed sparse row (CSR)
+ * format and the coefficients of the two objectives. CplexModel records it while the model is build through the bulk building functions.
+ * Once handed out by CplexModel::getModelData ( ) it is never changed, so any number of threads can build their own CplexModel from the same data
+ * without copying it and without calling user code.
+ */
+
+//! C++ includes
+#include<vector>
+#include<ilcplex/ilocplex.h>
+
+struct ModelData{
+    std::vector< double > ColLB;            //!< Lower bound of each variable in AllVars
+    std::vector< double > ColUB;            //!< Upper bound of each variable in AllVars
+    std::vector< IloNumVarType > ColType;   //!< Type of each variable in AllVars
+    std::vector< double > RowLB;            //!< Lower bound of each row
+    std::vector< double > RowUB;            //!< Upper bound of each row
+    std::vector< int > RowStart = std::vector< int > ( 1 , 0 ); //!< Row r holds the nonzeros RowStart[r] to RowStart[r+1]-1. Has one entry more than the number of rows
+    std::vector< int > RowInd;              //!< Column indices (into AllVars) of the nonzeros
+    std::vector< double > RowVal;           //!< Values of the nonzeros
+    std::vector< double > C1;               //!< Coefficients of the first objective. Empty until the objectives are linked
+    std::vector< double > C2;               //!< Coefficients of the second objective. Empty until the objectives are linked
+
+    /*!
+     * Returns the number of variables
+     */
+    size_t numberOfColumns ( ) const { return ColLB.size ( ); }
+
+    /*!
+     * Returns the number of rows, not counting the rows defining f1 and f2
+     */
+    size_t numberOfRows ( ) const { return RowLB.size ( ); }
+}; //!< Struct used to hold an immutable copy of the base problem, shared by the models built from it
+
+#endif // MODELDATA_H_INCLUDED
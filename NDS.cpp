@@ -7,10 +7,102 @@
  */
 
 /********************************************************************************************/
-NDS::NDS(){}
+NDS::NDS():RefFirst ( 0.0 ), RefSecond ( 0.0 ), HasReference ( false ), HyperVolume ( 0.0 ), MemoryCeiling ( 0 ), ResidentBytes ( 0 ),
+           IntegerMode ( false ), GridTolerance ( 0.01 ), NDs ( ), SupNDs ( ) {}
 
 /********************************************************************************************/
-NDS::NDS( const NDS& other ):NDs ( other.NDs ), SupNDs ( other.SupNDs ) {}
+NDS::NDS( const NDS& other ):TheWorstLocalNadirPoint ( other.TheWorstLocalNadirPoint ), RefFirst ( other.RefFirst ), RefSecond ( other.RefSecond ),
+                             HasReference ( other.HasReference ), HyperVolume ( other.HyperVolume ), MemoryCeiling ( other.MemoryCeiling ),
+                             ResidentBytes ( other.ResidentBytes ), Log ( other.Log ), IntegerMode ( other.IntegerMode ), GridTolerance ( other.GridTolerance ),
+                             Keys ( other.Keys ), NDs ( other.NDs ), SupNDs ( other.SupNDs ) {}
+
+/********************************************************************************************/
+double NDS::contribution ( std::list< solution >::const_iterator it ) const
+{
+    // NDs is sorted by increasing first (and decreasing second) coordinate, so *it alone dominates the slab up to the next point
+    auto next = std::next ( it );
+    double right = ( next == NDs.end ( ) ) ? RefFirst : std::min ( next->getFirst ( ) , RefFirst );
+    double width = right - it->getFirst ( );
+    double height = RefSecond - it->getSecond ( );
+    return ( width > 0.0 && height > 0.0 ) ? width * height : 0.0;
+}
+
+/********************************************************************************************/
+std::list< solution >::iterator NDS::insertNDs ( std::list< solution >::iterator pos, const solution &sol )
+{
+    OUTCOME key;
+    bool Indexed = IntegerMode && toGrid ( sol , key );
+    // Only the slab of the point before sol changes
+    auto prev = ( !HasReference || pos == NDs.begin ( ) ) ? NDs.end ( ) : std::prev ( pos );
+    if ( prev != NDs.end ( ) ) HyperVolume -= contribution ( prev );
+    std::list< solution >::iterator it = NDs.insert ( pos , sol );
+    if ( Indexed )
+    {   // The outcome is rounded once, here, so all later compares are exact
+        it->roundOutcome ( );
+        Keys.insert ( key );
+    }
+    if ( HasReference ) HyperVolume += contribution ( it );
+    if ( prev != NDs.end ( ) ) HyperVolume += contribution ( prev );
+    ResidentBytes += it->getResidentBytes ( );
+    if ( MemoryCeiling > 0 && ResidentBytes > MemoryCeiling ) spillPayloads ( );
+    return it;
+}
+
+/********************************************************************************************/
+std::list< solution >::iterator NDS::eraseNDs ( std::list< solution >::iterator it )
+{
+    ResidentBytes -= std::min ( ResidentBytes , it->getResidentBytes ( ) );
+    if ( IntegerMode ) Keys.erase ( OUTCOME ( std::llround ( it->getFirst ( ) ) , std::llround ( it->getSecond ( ) ) ) );
+    if ( !HasReference ) return NDs.erase ( it );
+    auto prev = ( it == NDs.begin ( ) ) ? NDs.end ( ) : std::prev ( it );
+    if ( prev != NDs.end ( ) ) HyperVolume -= contribution ( prev );
+    HyperVolume -= contribution ( it );
+    auto next = NDs.erase ( it );
+    if ( prev != NDs.end ( ) ) HyperVolume += contribution ( prev );
+    return next;
+}
+
+/********************************************************************************************/
+void NDS::setMemoryCeiling ( size_t bytes )
+{
+    MemoryCeiling = bytes;
+    if ( MemoryCeiling > 0 && ResidentBytes > MemoryCeiling ) spillPayloads ( );
+}
+
+/********************************************************************************************/
+void NDS::spillPayloads ( )
+{
+    // Only the outcome vectors are used while the frontier is built, so every decision vector in memory is cold
+    if ( !Log ) Log = std::make_shared< SpillLog > ( );
+    for ( auto it = NDs.begin ( ); it != NDs.end ( ); ++it ) it->spill ( Log );
+    ResidentBytes = 0;
+}
+
+/********************************************************************************************/
+size_t NDS::getNumberOfSpilledSolutions ( ) const
+{
+    size_t spilled = 0;
+    for ( auto it = NDs.begin ( ); it != NDs.end ( ); ++it ) if ( it->isSpilled ( ) ) ++spilled;
+    return spilled;
+}
+
+/********************************************************************************************/
+void NDS::setReferencePoint ( double r1, double r2 )
+{
+    RefFirst        = r1;
+    RefSecond       = r2;
+    HasReference    = true;
+    recomputeHyperVolume ( );
+}
+
+/********************************************************************************************/
+void NDS::recomputeHyperVolume ( )
+{
+    if ( IntegerMode ) rebuildKeys ( );
+    HyperVolume = 0.0;
+    if ( !HasReference ) return;
+    for ( auto it = NDs.cbegin ( ); it != NDs.cend ( ); ++it ) HyperVolume += contribution ( it );
+}
 
 /********************************************************************************************/
 void NDS::addToSupportedNDs( const solution &s ){
@@ -38,20 +130,36 @@ void NDS::addToSupportedNDs( const solution &s ){
 }
 
 /********************************************************************************************/
-void NDS::updateNDS( const solution &sol)
+void NDS::updateNDS( const solution &candidate )
 {
     try
     {
         bool pShouldInsert = true;
+        double tol = 0.1;       // Outcomes closer than this are considered equal. Zero in integer mode, where the compares are exact
+        solution rounded;       // Copy of candidate with its outcome rounded, if it is not integral already
+        const solution *in = &candidate;
+        OUTCOME key;
+        if ( IntegerMode && toGrid ( candidate , key ) )
+        {
+            if ( Keys.count ( key ) > 0 ) return; // The outcome is on NDs already
+            tol = 0.0;
+            if ( candidate.getFirst ( ) != key.first || candidate.getSecond ( ) != key.second )
+            {
+                rounded = candidate;
+                rounded.roundOutcome ( );
+                in = &rounded;
+            }
+        }
+        const solution &sol = *in;
 
         if ( NDs.size( ) == 0 ){
-            NDs.push_back( sol );
+            insertNDs( NDs.end ( ) , sol );
             return;
         }
         auto it = NDs.begin();
         while( it != NDs.end() ){
             // Check each element if p is dominated
-            if ( ( it->getFirst( )-0.1<=sol.getFirst( ) ) && ( it->getSecond( )-0.1<=sol.getSecond( ) ) ){
+            if ( ( it->getFirst( )-tol<=sol.getFirst( ) ) && ( it->getSecond( )-tol<=sol.getSecond( ) ) ){
                 // sol is dominated by *it and nothing more should be done!
                 //std::cout << "Should not be added\n";
                 pShouldInsert = false;
@@ -59,28 +167,21 @@ void NDS::updateNDS( const solution &sol)
             // Now check if sol dominates *it
             }else if ( (( it->getFirst( )>sol.getFirst( ) ) && (it->getSecond( )>=sol.getSecond() )) || ( (it->getFirst()>=sol.getFirst()) && (it->getSecond()>sol.getSecond()) ) ){
                 // sol dominates *it. We erase it, insert sol instead and check the following points for domination
-                auto insertIt = NDs.erase ( it );
-                NDs.insert ( insertIt , sol );
+                it = insertNDs ( eraseNDs ( it ) , sol );
                 // We insert p instead of the one it dominates. Therefore, we should not insert it again
                 pShouldInsert = false;
                 // We loop through the rest of the vector of solutions to see if more solutions are dominated.
                 // If so, we delete the solution. The erase function returns an iterator to the next element on the list
                 // Therefore we automatically increment the iterator. Furthermore, we loop only as long as the solution is dominated by the new solution
                 for ( auto itt = std::next(it); itt!=NDs.end(); ){
-                    std::cout << "Starting to erase\n";
-                    if ( (sol.getFirst()<=itt->getFirst()+0.1) && (sol.getSecond() <= itt->getSecond()+0.1) )
+                    if ( (sol.getFirst()<=itt->getFirst()+tol) && (sol.getSecond() <= itt->getSecond()+tol) )
                     {
-                        itt = NDs.erase(itt);
+                        TPM_LOG ( LOG_DEBUG , "nds_erase f1=" << itt->getFirst ( ) << " f2=" << itt->getSecond ( ) );
+                        itt = eraseNDs(itt);
                     }
                     else ++itt;
                 }
-                if ( NDs.size() >= 2 ){
-                    TheWorstLocalNadirPoint =  std::numeric_limits<double>::min( ) ;
-                    for ( auto it = std::next(NDs.begin()); it!=NDs.end(); ++it ){
-                        double NadirPoint = it->getFirst( ) + std::prev(it)->getSecond( );
-                        if ( NadirPoint > TheWorstLocalNadirPoint ) TheWorstLocalNadirPoint = NadirPoint;
-                    }
-                }
+                if ( NDs.size() >= 2 ) updateWorstLocalNadirPoint ( );
             }else ++it;
         }
         // If p survives the check, it is added at the end and the pareto front is sorted
@@ -91,22 +192,179 @@ void NDS::updateNDS( const solution &sol)
             {
                 if ( it->getFirst( ) > sol.getFirst( ) )
                 { // As sol parsed the tests above, we know that sol should be inserted before the first solution which has a first coordinate larger than sol itself
-                    NDs.insert( it , sol );
                     break;
                 }
                 ++it;
             }
+            insertNDs ( it , sol ); // If no solution has a larger first coordinate, sol goes at the end
+            updateWorstLocalNadirPoint ( );
+        }
 
-            TheWorstLocalNadirPoint = std::numeric_limits<double>::min( ) ;
-            for ( auto it = std::next(NDs.begin()); it!=NDs.end(); ++it ){
-                double NadirPoint = it->getFirst( ) + std::prev(it)->getSecond( );
-                if ( NadirPoint > TheWorstLocalNadirPoint ) TheWorstLocalNadirPoint = NadirPoint;
-            }
+    }catch(std::exception &e)
+    {
+        std::cerr << "Exception in updateNDS in the NDS class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void NDS::updateWorstLocalNadirPoint ( )
+{
+    TheWorstLocalNadirPoint = std::numeric_limits<double>::min( ) ;
+    for ( auto it = std::next(NDs.begin()); it!=NDs.end(); ++it ){
+        double NadirPoint = it->getFirst( ) + std::prev(it)->getSecond( );
+        if ( NadirPoint > TheWorstLocalNadirPoint ) TheWorstLocalNadirPoint = NadirPoint;
+    }
+}
+
+/********************************************************************************************/
+bool NDS::toGrid ( const solution &sol, OUTCOME &key )
+{
+    const double Largest = 9007199254740992.0; // 2^53. Larger integers are not exact as doubles
+    double r1 = std::round ( sol.getFirst ( ) ),
+           r2 = std::round ( sol.getSecond ( ) );
+    if ( std::fabs ( sol.getFirst ( ) - r1 ) > GridTolerance || std::fabs ( sol.getSecond ( ) - r2 ) > GridTolerance ||
+         std::fabs ( r1 ) > Largest || std::fabs ( r2 ) > Largest )
+    {
+        TPM_LOG ( LOG_WARNING , "nds_integer_mode off f1=" << sol.getFirst ( ) << " f2=" << sol.getSecond ( ) << " tolerance=" << GridTolerance );
+        IntegerMode = false;
+        Keys.clear ( );
+        return false;
+    }
+    key = OUTCOME ( int64_t ( r1 ) , int64_t ( r2 ) );
+    return true;
+}
+
+/********************************************************************************************/
+void NDS::rebuildKeys ( )
+{
+    Keys.clear ( );
+    OUTCOME key;
+    for ( auto it = NDs.begin ( ); it != NDs.end ( ) && IntegerMode; ++it )
+    {
+        if ( !toGrid ( *it , key ) ) return;
+        it->roundOutcome ( );
+        Keys.insert ( key );
+    }
+}
+
+/********************************************************************************************/
+void NDS::setIntegerCoordinates ( bool on, double tolerance )
+{
+    GridTolerance = tolerance;
+    if ( on == IntegerMode ) return;
+    IntegerMode = on;
+    Keys.clear ( );
+    if ( IntegerMode && !NDs.empty ( ) ) recomputeHyperVolume ( ); // Rounds NDs and rebuilds the index
+}
+
+/********************************************************************************************/
+void NDS::updateNDS ( const std::vector< solution > &sols )
+{
+    try
+    {
+        /*================================================*/
+        /*      Round the batch once and drop repeats     */
+        /*================================================*/
+        std::vector< int64_t > F1, F2;  // Integer outcomes of the candidates left
+        std::vector< size_t > Index;    // Position in sols of each candidate left
+        std::unordered_set< OUTCOME , OUTCOMEHASH > Seen;
+        F1.reserve ( sols.size ( ) );
+        F2.reserve ( sols.size ( ) );
+        Index.reserve ( sols.size ( ) );
+        OUTCOME key;
+        for ( size_t i = 0; i < sols.size ( ) && IntegerMode; ++i )
+        {
+            if ( !toGrid ( sols[i] , key ) ) break;
+            if ( Keys.count ( key ) > 0 || !Seen.insert ( key ).second ) continue;
+            F1.push_back ( key.first );
+            F2.push_back ( key.second );
+            Index.push_back ( i );
+        }
+        if ( !IntegerMode )
+        {   // Not (or no longer) in integer mode. Insert one at a time with the tolerance
+            for ( auto it = sols.begin ( ); it != sols.end ( ); ++it ) updateNDS ( *it );
+            return;
         }
 
+        /*================================================*/
+        /*      Filter the batch on its own               */
+        /*================================================*/
+        // Sorted by the first objective (ties by the second), a candidate is dominated iff an earlier one has a second objective no larger than its own
+        size_t n = Index.size ( );
+        std::vector< size_t > Order ( n );
+        for ( size_t k = 0; k < n; ++k ) Order[k] = k;
+        std::sort ( Order.begin ( ) , Order.end ( ) , [&] ( size_t a, size_t b ) { return F1[a] < F1[b] || ( F1[a] == F1[b] && F2[a] < F2[b] ); } );
+        std::vector< int64_t > S2 ( n );
+        for ( size_t k = 0; k < n; ++k ) S2[k] = F2[Order[k]];
+        std::vector< char > Keep ( n );
+        int64_t Min = std::numeric_limits< int64_t >::max ( );
+        for ( size_t k = 0; k < n; ++k )
+        {   // Branch free running minimum
+            Keep[k] = ( S2[k] < Min );
+            Min = std::min ( Min , S2[k] );
+        }
+
+        /*================================================*/
+        /*      Merge the survivors with NDs              */
+        /*================================================*/
+        // The same sweep over the union of NDs and the survivors removes the points of NDs which are dominated by the batch
+        auto it = NDs.begin ( );
+        Min = std::numeric_limits< int64_t >::max ( );
+        auto Sweep = [&] ( int64_t f1, int64_t f2 )
+        {   // Moves past the points of NDs before ( f1 , f2 ) in the order, erasing those which are dominated
+            while ( it != NDs.end ( ) )
+            {
+                int64_t g1 = std::llround ( it->getFirst ( ) ), g2 = std::llround ( it->getSecond ( ) );
+                if ( g1 > f1 || ( g1 == f1 && g2 > f2 ) ) break;
+                if ( g2 < Min )
+                {
+                    Min = g2;
+                    ++it;
+                }
+                else
+                {
+                    TPM_LOG ( LOG_DEBUG , "nds_erase f1=" << it->getFirst ( ) << " f2=" << it->getSecond ( ) );
+                    it = eraseNDs ( it );
+                }
+            }
+        };
+        bool Changed = false;
+        for ( size_t k = 0; k < n; ++k )
+        {
+            if ( !Keep[k] ) continue;
+            int64_t f1 = F1[Order[k]], f2 = S2[k];
+            Sweep ( f1 , f2 );
+            if ( f2 < Min )
+            {
+                Min = f2;
+                insertNDs ( it , sols[Index[Order[k]]] );
+                Changed = true;
+            }
+        }
+        Sweep ( std::numeric_limits< int64_t >::max ( ) , std::numeric_limits< int64_t >::max ( ) );
+        if ( Changed && NDs.size ( ) >= 2 ) updateWorstLocalNadirPoint ( );
     }catch(std::exception &e)
     {
         std::cerr << "Exception in updateNDS in the NDS class : " << e.what ( ) << std::endl;
         exit ( EXIT_FAILURE );
     }
 }
+
+/********************************************************************************************/
+void NDS::retain ( const std::vector< bool > &keep )
+{
+    if ( keep.size ( ) != NDs.size ( ) ) throw std::invalid_argument ( "retain needs one entry for each solution on NDs" );
+    size_t i = 0;
+    for ( auto it = NDs.begin ( ); it != NDs.end ( ); ++i ) it = keep[i] ? std::next ( it ) : eraseNDs ( it );
+    if ( NDs.size ( ) >= 2 ) updateWorstLocalNadirPoint ( );
+
+    // Both lists are sorted by the first objective, so a single sweep finds the supported solutions still on NDs
+    auto it = NDs.begin ( );
+    for ( auto sup = SupNDs.begin ( ); sup != SupNDs.end ( ); )
+    {
+        while ( it != NDs.end ( ) && it->getFirst ( ) < sup->getFirst ( ) - 0.1 ) ++it;
+        bool Kept = ( it != NDs.end ( ) && std::fabs ( it->getFirst ( ) - sup->getFirst ( ) ) <= 0.1 && std::fabs ( it->getSecond ( ) - sup->getSecond ( ) ) <= 0.1 );
+        sup = Kept ? std::next ( sup ) : SupNDs.erase ( sup );
+    }
+}
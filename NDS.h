@@ -14,13 +14,70 @@
 #include<iostream>
 #include<stdexcept>
 #include<limits>
+#include<memory>
+#include<algorithm>
+#include<unordered_set>
+#include<cstdint>
+#include<cmath>
 
 //! My own C++ includes
 #include"solution.h"
+#include"Logger.h"
 
 class NDS{
 
+       typedef std::pair< int64_t , int64_t > OUTCOME; //! Outcome vector rounded to integers
+
+       struct OUTCOMEHASH{
+           size_t operator() ( const OUTCOME &key ) const { return std::hash< int64_t > ( ) ( key.first ) ^ ( std::hash< int64_t > ( ) ( key.second ) * 0x9e3779b97f4a7c15ULL ); }
+       }; //! Hash of an integer outcome vector
+
        double TheWorstLocalNadirPoint;
+       double RefFirst;     //! First coordinate of the reference point of the hypervolume
+       double RefSecond;    //! Second coordinate of the reference point of the hypervolume
+       bool HasReference;   //! True if a reference point has been set
+       double HyperVolume;  //! Hypervolume of NDs with respect to the reference point. Maintained on every insertion and deletion
+       size_t MemoryCeiling;    //! Maximum number of bytes used by the variable values of the solutions in NDs. Zero means no limit
+       size_t ResidentBytes;    //! Number of bytes used by the variable values of the solutions in NDs which are in memory
+       std::shared_ptr< SpillLog > Log; //! Log holding the spilled variable values. Created when the memory ceiling is first exceeded
+       bool IntegerMode;    //! If true, outcomes are rounded to integers when they are inserted into NDs, and compared exactly
+       double GridTolerance;    //! Largest distance from an outcome to the nearest integer accepted in integer mode
+       std::unordered_set< OUTCOME , OUTCOMEHASH > Keys; //! The outcomes on NDs in integer mode, so repeated outcomes are rejected without traversing NDs
+
+       /*!
+        * Rounds the outcome of sol to integers. Returns false, and leaves integer mode, if it is further than GridTolerance from them
+        */
+       bool toGrid ( const solution &sol, OUTCOME &key );
+
+       /*!
+        * Rebuilds Keys from NDs, rounding the outcomes on NDs. Leaves integer mode if one of them is not integral
+        */
+       void rebuildKeys ( );
+
+       /*!
+        * Recomputes TheWorstLocalNadirPoint from NDs
+        */
+       void updateWorstLocalNadirPoint ( );
+
+       /*!
+        * Moves the variable values of all solutions in NDs to the spill log
+        */
+       void spillPayloads ( );
+
+       /*!
+        * Returns the area of the region dominated by *it, but not by any point following it on NDs, inside the reference box
+        */
+       double contribution ( std::list< solution >::const_iterator it ) const;
+
+       /*!
+        * Inserts sol into NDs before pos and updates the hypervolume. Returns an iterator to the inserted solution
+        */
+       std::list< solution >::iterator insertNDs ( std::list< solution >::iterator pos, const solution &sol );
+
+       /*!
+        * Erases *it from NDs and updates the hypervolume. Returns an iterator to the following solution
+        */
+       std::list< solution >::iterator eraseNDs ( std::list< solution >::iterator it );
 
     public:
         std::list< solution > NDs; //! Set of non-dominated solutions
@@ -53,6 +110,12 @@ class NDS{
         inline
         bool isEmpty ( ) { return SupNDs.empty(); }
 
+        /*!
+         * Function clearing both the set of non dominated solutions and the list of supported non dominated solutions
+         */
+        inline
+        void clear ( ) { NDs.clear(); SupNDs.clear(); Keys.clear(); HyperVolume = 0.0; ResidentBytes = 0; }
+
         /*!
          * Function adding a solution to the list of supported non dominated solutions
          */
@@ -70,7 +133,14 @@ class NDS{
          * Function copying the set of supported non dominated solutions into the set of non dominated solutions
          */
         inline
-        void copySupToNonDom ( ){ for ( auto it = SupNDs.begin(); it!=SupNDs.end(); ++it ) NDs.push_back ( *it ); }
+        void copySupToNonDom ( ){ for ( auto it = SupNDs.begin(); it!=SupNDs.end(); ++it ) insertNDs ( NDs.end ( ) , *it ); }
+
+        /*!
+         * Function removing solutions from NDs, keeping the hypervolume, the memory count and the index of integer mode up to date.
+         * Supported solutions whose outcome is no longer on NDs are removed from SupNDs as well
+         * \param keep constant reference to a vector of bools. Has an entry for each solution on NDs, in order. The solutions with a false entry are removed
+         */
+        void retain ( const std::vector< bool > &keep );
 
         /*!
          * Adds a point p to NDs if it is non--dominated by all points in UBset.
@@ -79,6 +149,61 @@ class NDS{
          */
         void updateNDS(const solution &sol);
 
+        /*!
+         * Adds the non--dominated solutions of a batch to NDs, and removes the solutions on NDs they dominate. Same result as calling updateNDS
+         * for each solution, but in integer mode the batch is filtered on its own first: repeated outcomes are removed through the hash index,
+         * the rest are sorted, and a single pass of integer compares keeps the non--dominated ones. They are then merged with NDs in one traversal.
+         * Outside integer mode, updateNDS is called for each solution.
+         * \param sols constant reference to a vector of solutions. Solutions harvested from the solution pool, ranking or a heuristic
+         */
+        void updateNDS ( const std::vector< solution > &sols );
+
+        /*!
+         * Turns integer mode on or off. In integer mode the outcomes are rounded to integers (and checked to be within tolerance of them) once,
+         * when they are inserted into NDs, and compared exactly afterwards instead of with a tolerance of 0.1. Repeated outcomes are rejected by a hash
+         * index before NDs is traversed. If an outcome further than tolerance from the integers is met, integer mode is left for good, and a warning is logged.
+         * \param on boolean. Default is off
+         * \param tolerance double. Largest distance to the nearest integer accepted. Default is 0.01
+         */
+        void setIntegerCoordinates ( bool on, double tolerance = 0.01 );
+
+        /*!
+         * Returns true if integer mode is on
+         */
+        inline
+        bool hasIntegerCoordinates ( ) const { return IntegerMode; }
+
+        /*!
+         * Sets the reference point of the hypervolume and computes the hypervolume of NDs from scratch.
+         * The reference point should be weakly dominated by every point on the frontier, for instance the nadir point plus one.
+         * \param r1 double. First coordinate of the reference point
+         * \param r2 double. Second coordinate of the reference point
+         */
+        void setReferencePoint ( double r1, double r2 );
+
+        /*!
+         * Computes the hypervolume of NDs (and in integer mode the hash index of its outcomes) from scratch. Must be called if NDs has been changed directly
+         */
+        void recomputeHyperVolume ( );
+
+        /*!
+         * Returns the hypervolume of NDs, that is the area dominated by NDs and dominating the reference point. Zero if no reference point is set
+         */
+        inline
+        double getHyperVolume ( ) const { return HasReference ? HyperVolume : 0.0; }
+
+        /*!
+         * Sets a ceiling on the memory used by the variable values of the solutions in NDs. When it is exceeded, the variable values of all solutions
+         * are moved to a log in a temporary file, and they are read back from it by solution::getVarValues. The outcome vectors are always kept in memory.
+         * \param bytes size_t. The ceiling in bytes. Zero means no limit, which is the default
+         */
+        void setMemoryCeiling ( size_t bytes );
+
+        /*!
+         * Returns the number of solutions whose variable values have been moved to the spill log
+         */
+        size_t getNumberOfSpilledSolutions ( ) const;
+
 };
 
 #endif // NDS include guard ends here
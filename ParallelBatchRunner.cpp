@@ -0,0 +1,132 @@
+#include"ParallelBatchRunner.h"
+
+#include<thread>
+#include<algorithm>
+#include<numeric>
+#include<cmath>
+
+/********************************************************************************************/
+inline
+double percentile ( const std::vector< double >& sorted, double q )
+{   // Nearest rank percentile of an already sorted vector
+    if ( sorted.empty ( ) ) return 0.0;
+    size_t rank = (size_t) std::ceil ( q * sorted.size ( ) );
+    if ( rank < 1 ) rank = 1;
+    return sorted[std::min ( rank , sorted.size ( ) ) - 1];
+}
+
+/********************************************************************************************/
+ParallelBatchRunner::ParallelBatchRunner ( int coreBudget ):
+    CoreBudget ( coreBudget ),
+    MinThreadsPerJob ( 1 ),
+    SizePerThread ( 5000.0 ),
+    FreeCores ( 0 )
+{
+    if ( CoreBudget <= 0 ) CoreBudget = std::max ( 1u , std::thread::hardware_concurrency ( ) );
+    MaxThreadsPerJob = CoreBudget;
+}
+
+/********************************************************************************************/
+void ParallelBatchRunner::setThreadsPerJob ( int minThreads, int maxThreads )
+{
+    MinThreadsPerJob = std::max ( 1 , std::min ( minThreads , CoreBudget ) );
+    MaxThreadsPerJob = std::max ( MinThreadsPerJob , std::min ( maxThreads , CoreBudget ) );
+}
+
+/********************************************************************************************/
+int ParallelBatchRunner::ChooseThreads ( double size, double workLeft, size_t jobsLeft ) const
+{
+    // A job gets the fraction of the cores that its size is of the work left, so the large jobs get the most threads and the
+    // jobs left can still run side by side on the other cores. Jobs of no size share the cores evenly
+    double fraction = ( workLeft > 0.0 ) ? size / workLeft : 1.0 / jobsLeft;
+    int share = (int) std::floor ( fraction * CoreBudget );
+    // A job never gets more threads than its size calls for
+    int threads = std::min ( (int) std::ceil ( size / SizePerThread ) , share );
+    return std::max ( MinThreadsPerJob , std::min ( threads , MaxThreadsPerJob ) );
+}
+
+/********************************************************************************************/
+std::vector< BatchResult > ParallelBatchRunner::run ( const std::vector< BatchJob >& jobs, BatchReport& report )
+{
+    std::vector< BatchResult > results ( jobs.size ( ) );
+    report.NumberOfJobs = jobs.size ( );
+    report.Latency.assign ( jobs.size ( ) , 0.0 );
+    report.Threads.assign ( jobs.size ( ) , 0 );
+    try
+    {
+        // Start the largest jobs first, so the batch does not end with one large job running on few threads
+        std::vector< size_t > order ( jobs.size ( ) );
+        std::iota ( order.begin ( ) , order.end ( ) , 0 );
+        std::stable_sort ( order.begin ( ) , order.end ( ) , [&jobs] ( size_t a, size_t b ) { return jobs[a].Size > jobs[b].Size; } );
+
+        FreeCores   = CoreBudget;
+        auto BatchStart = CPUclock::now ( );
+        double WorkLeft = 0.0; // Sum of the sizes of the jobs not yet started
+        for ( auto it = jobs.begin ( ); it != jobs.end ( ); ++it ) WorkLeft += std::max ( 0.0 , it->Size );
+        std::vector< std::thread > Workers;
+        Workers.reserve ( jobs.size ( ) );
+
+        for ( size_t k = 0; k < order.size ( ); ++k )
+        {
+            size_t job = order[k];
+            int threads = ChooseThreads ( std::max ( 0.0 , jobs[job].Size ) , WorkLeft , order.size ( ) - k );
+            WorkLeft -= std::max ( 0.0 , jobs[job].Size );
+            {   // Wait until enough cores are free
+                std::unique_lock< std::mutex > lock ( CoreMutex );
+                CoreCV.wait ( lock , [this,threads] { return FreeCores >= threads; } );
+                FreeCores -= threads;
+            }
+            report.Threads[job] = threads;
+
+            // Each job has its own environment, model and tpm object. Only the constant ModelData is shared between the threads
+            Workers.push_back ( std::thread ( [this,&jobs,&results,&report,job,threads] ( )
+            {
+                auto JobStart = CPUclock::now ( );
+                results[job].Instance = job;
+                try
+                {
+                    CplexModel theModel;
+                    tpm theTPM;
+                    if ( jobs[job].Data ) theModel.build ( jobs[job].Data );
+                    if ( jobs[job].Build ) jobs[job].Build ( theModel , theTPM );
+                    theTPM.setThreads ( threads );
+                    results[job].Status     = theTPM.RUN ( theModel );
+                    results[job].Statistics = *theTPM.getTestStatistics ( );
+                    results[job].Frontier   = theTPM.getNonDominatedSet ( );
+                }
+                catch ( ... )
+                {   // Hand the exception to the caller instead of terminating the batch
+                    results[job].Status = -1;
+                    results[job].Error  = std::current_exception ( );
+                }
+                report.Latency[job] = duration_cast< duration < double > > ( CPUclock::now ( ) - JobStart ).count ( );
+
+                std::lock_guard< std::mutex > lock ( CoreMutex );
+                FreeCores += threads;
+                CoreCV.notify_all ( );
+            } ) );
+        }
+
+        // Wait for the last jobs to finish
+        for ( auto it = Workers.begin ( ); it != Workers.end ( ); ++it ) it->join ( );
+
+        /*================================================*/
+        /*      Aggregate statistics                      */
+        /*================================================*/
+        report.WallTime     = duration_cast< duration < double > > ( CPUclock::now ( ) - BatchStart ).count ( );
+        report.Throughput   = ( report.WallTime > 0.0 ) ? jobs.size ( ) / report.WallTime : 0.0;
+        std::vector< double > sorted ( report.Latency );
+        std::sort ( sorted.begin ( ) , sorted.end ( ) );
+        report.MeanLatency  = sorted.empty ( ) ? 0.0 : std::accumulate ( sorted.begin ( ) , sorted.end ( ) , 0.0 ) / sorted.size ( );
+        report.LatencyP50   = percentile ( sorted , 0.50 );
+        report.LatencyP90   = percentile ( sorted , 0.90 );
+        report.LatencyP99   = percentile ( sorted , 0.99 );
+        report.MaxLatency   = sorted.empty ( ) ? 0.0 : sorted.back ( );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in run in the ParallelBatchRunner class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    return results;
+}
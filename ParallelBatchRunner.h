@@ -0,0 +1,90 @@
+#ifndef PARALLELBATCHRUNNER_H_INCLUDED
+#define PARALLELBATCHRUNNER_H_INCLUDED
+
+/**
+ * Class used to run many independent two phase method solves at the same time on a fixed budget of cores.
+ * Each job gets its own CplexModel (and thereby its own IloEnv) and its own tpm object, and a number of cplex
+ * threads chosen from the size of the job. Small jobs are packed many per node, large jobs get more threads.
+ */
+
+//! C++ includes
+#include<vector>
+#include<functional>
+#include<mutex>
+#include<condition_variable>
+#include<chrono>
+
+//! My own C++ includes
+#include"tpm.h"         //! The two phase method
+#include"CplexModel.h"  //! The class holding the cplex model
+#include"BatchSolver.h" //! BatchResult
+
+struct BatchJob{
+    double Size;    //!< Estimate of the size of the job, for example the number of variables. Used to choose the number of threads
+    std::function< void ( CplexModel& theModel, tpm& theTPM ) > Build; //!< Builds the instance in theModel and sets the parameters of theTPM
+    std::shared_ptr< const ModelData > Data; //!< If set, theModel is built from it before Build is called, so Build only has to set the parameters of theTPM (and may be empty)
+}; //!< Struct describing a single job of a parallel batch. Jobs solving the same instance with different parameters should share one ModelData
+
+struct BatchReport{
+    size_t NumberOfJobs;        //!< Number of jobs run
+    double WallTime;            //!< Wall clock time in seconds for the whole batch
+    double Throughput;          //!< Jobs finished per second
+    double MeanLatency;         //!< Mean time in seconds from the start of a job until it finished
+    double LatencyP50;          //!< Median latency in seconds
+    double LatencyP90;          //!< 90th percentile of the latency in seconds
+    double LatencyP99;          //!< 99th percentile of the latency in seconds
+    double MaxLatency;          //!< Largest latency in seconds
+    std::vector< double > Latency;  //!< Latency in seconds of each job, in the order the jobs were given
+    std::vector< int > Threads;     //!< Number of cplex threads given to each job, in the order the jobs were given
+}; //!< Struct used to report aggregate statistics for a parallel batch
+
+class ParallelBatchRunner{
+    private:
+        int CoreBudget;         //!< Total number of cores the batch may use
+        int MinThreadsPerJob;   //!< Fewest cplex threads given to a job
+        int MaxThreadsPerJob;   //!< Most cplex threads given to a job
+        double SizePerThread;   //!< A job gets one thread per SizePerThread units of size (within the limits above)
+
+        int FreeCores;                  //!< Cores not currently used by a running job
+        std::mutex CoreMutex;           //!< Protects FreeCores
+        std::condition_variable CoreCV; //!< Signalled each time a job finishes
+
+        /*! \brief Chooses the number of cplex threads for a job
+         * \param size double. The size estimate of the job
+         * \param workLeft double. Sum of the size estimates of the jobs not yet started, including this one
+         * \param jobsLeft size_t. Number of jobs not yet started, including this one
+         * \return int. The number of threads
+         */
+        int ChooseThreads ( double size, double workLeft, size_t jobsLeft ) const;
+
+    public:
+        /*! \brief Constructor
+         * \param coreBudget integer. The number of cores the batch may use. Zero (default) means all cores of the machine
+         */
+        ParallelBatchRunner ( int coreBudget = 0 );
+
+        /*! \brief Sets the limits on the number of threads per job
+         * \param minThreads integer. Fewest threads a job is given. Default is one
+         * \param maxThreads integer. Most threads a job is given. Default is the core budget
+         */
+        void setThreadsPerJob ( int minThreads, int maxThreads );
+
+        /*! \brief Sets how the size of a job maps to threads
+         * \param size double. A job is given one thread per size units, within the limits set by setThreadsPerJob. Default is 5000
+         */
+        void setSizePerThread ( double size ) { SizePerThread = size; }
+
+        /*! \brief Runs all jobs, never using more than the core budget at a time
+         *
+         * Jobs are started largest first, each as soon as enough cores are free. A job is given the fraction of the core budget that its size is
+         * of the total size of the jobs not yet started (within the limits above), so the large jobs get the most threads and many small jobs run
+         * side by side. An exception thrown by the user code in Build ends only its own job, and is returned in the Error field of its BatchResult.
+         * Errors inside CplexModel and tpm (including CplexModel::build from an inconsistent ModelData) print a message and end the process, as they do in a single run.
+         * \param jobs constant reference to a vector of BatchJobs. The jobs to run
+         * \param report reference to a BatchReport. Holds throughput and latency statistics on output
+         * \return vector of BatchResults. One result per job, in the order the jobs were given
+         */
+        std::vector< BatchResult > run ( const std::vector< BatchJob >& jobs, BatchReport& report );
+};
+
+#endif // PARALLELBATCHRUNNER_H_INCLUDED
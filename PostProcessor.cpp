@@ -0,0 +1,94 @@
+#include"PostProcessor.h"
+
+#include<iostream>
+#include<exception>
+#include<cstdlib>
+
+/********************************************************************************************/
+PostProcessor::PostProcessor ( ):
+    Pending ( 0 ),
+    Stop ( false ),
+    Running ( false )
+{}
+
+/********************************************************************************************/
+PostProcessor::~PostProcessor ( )
+{
+    stop ( );
+}
+
+/********************************************************************************************/
+void PostProcessor::start ( )
+{
+    std::lock_guard< std::mutex > lock ( QueueMutex );
+    if ( Running ) return;
+    Stop = false;
+    Running = true;
+    Worker = std::thread ( &PostProcessor::WorkerLoop , this );
+}
+
+/********************************************************************************************/
+void PostProcessor::stop ( )
+{
+    {
+        std::lock_guard< std::mutex > lock ( QueueMutex );
+        if ( !Running ) return;
+        Stop = true;
+    }
+    TaskCV.notify_one ( );
+    Worker.join ( );
+    std::lock_guard< std::mutex > lock ( QueueMutex );
+    Running = false;
+}
+
+/********************************************************************************************/
+void PostProcessor::submit ( std::function< void ( ) > task )
+{
+    {
+        std::lock_guard< std::mutex > lock ( QueueMutex );
+        if ( Running )
+        {
+            Tasks.push_back ( std::move ( task ) );
+            ++Pending;
+            TaskCV.notify_one ( );
+            return;
+        }
+    }
+    task ( ); // No worker thread, so the task is run right away
+}
+
+/********************************************************************************************/
+void PostProcessor::drain ( )
+{
+    std::unique_lock< std::mutex > lock ( QueueMutex );
+    DoneCV.wait ( lock , [this] { return Pending == 0; } );
+}
+
+/********************************************************************************************/
+void PostProcessor::WorkerLoop ( )
+{
+    try
+    {
+        while ( true )
+        {
+            std::function< void ( ) > task;
+            {
+                std::unique_lock< std::mutex > lock ( QueueMutex );
+                TaskCV.wait ( lock , [this] { return Stop || !Tasks.empty ( ); } );
+                if ( Tasks.empty ( ) ) return; // Stop is true and all tasks are done
+                task = std::move ( Tasks.front ( ) );
+                Tasks.pop_front ( );
+            }
+            task ( );
+            {
+                std::lock_guard< std::mutex > lock ( QueueMutex );
+                if ( --Pending == 0 ) DoneCV.notify_all ( );
+            }
+        }
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in WorkerLoop in the PostProcessor class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
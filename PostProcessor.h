@@ -0,0 +1,65 @@
+#ifndef POSTPROCESSOR_H_INCLUDED
+#define POSTPROCESSOR_H_INCLUDED
+
+/**
+ * Class running the work following a cplex solve on a background thread, so the next solve can start right away.
+ * Tasks are run one at a time in the order they are submitted, so tasks updating the non-dominated set and printing
+ * see the same order of events as if they were run in the solve loop. Anything reading data written by the tasks must call drain first.
+ */
+
+//! C++ includes
+#include<deque>
+#include<functional>
+#include<mutex>
+#include<condition_variable>
+#include<thread>
+
+class PostProcessor{
+    private:
+        std::deque< std::function< void ( ) > > Tasks;  //!< Tasks submitted but not started
+        size_t Pending;                                 //!< Number of tasks submitted but not finished
+        bool Stop;                                      //!< If true, the worker thread finishes the remaining tasks and returns
+        bool Running;                                   //!< True while the worker thread is running
+        std::mutex QueueMutex;                          //!< Protects the members above
+        std::condition_variable TaskCV;                 //!< Signalled when a task is submitted or the worker must stop
+        std::condition_variable DoneCV;                 //!< Signalled when the last pending task is finished
+        std::thread Worker;                             //!< The thread running the tasks
+
+        /*!
+         * Main loop of the worker thread
+         */
+        void WorkerLoop ( );
+
+    public:
+        /*!
+         * Default constructor. The worker thread is not started, so submitted tasks are run right away by the calling thread
+         */
+        PostProcessor ( );
+
+        /*!
+         * Destructor. Stops the worker thread after it has run the remaining tasks
+         */
+        ~PostProcessor ( );
+
+        /*!
+         * Starts the worker thread. Does nothing if it is running already
+         */
+        void start ( );
+
+        /*!
+         * Runs the remaining tasks and stops the worker thread
+         */
+        void stop ( );
+
+        /*! \brief Submits a task
+         * \param task function taking no arguments. Is run on the worker thread, or right away if the worker thread is not running
+         */
+        void submit ( std::function< void ( ) > task );
+
+        /*!
+         * Waits until all submitted tasks are finished
+         */
+        void drain ( );
+};
+
+#endif // POSTPROCESSOR_H_INCLUDED
@@ -0,0 +1,53 @@
+#include"SpillLog.h"
+
+#include<stdexcept>
+#include<cstdint>
+
+/********************************************************************************************/
+SpillLog::SpillLog ( ):
+    File ( std::tmpfile ( ) ),
+    End ( 0 ),
+    NumberOfRecords ( 0 )
+{
+    if ( File == nullptr ) throw std::runtime_error ( "Could not create the temporary file of the spill log" );
+}
+
+/********************************************************************************************/
+SpillLog::~SpillLog ( )
+{
+    if ( File != nullptr ) std::fclose ( File );
+}
+
+/********************************************************************************************/
+long long SpillLog::append ( const std::vector< double > &values )
+{
+    std::lock_guard< std::mutex > lock ( LogMutex );
+    long long offset = End;
+    uint64_t n = values.size ( );
+    if ( fseeko ( File , offset , SEEK_SET ) != 0
+         || std::fwrite ( &n , sizeof ( n ) , 1 , File ) != 1
+         || ( n > 0 && std::fwrite ( values.data ( ) , sizeof ( double ) , n , File ) != n ) )
+        throw std::runtime_error ( "Could not write to the spill log" );
+    End += sizeof ( n ) + n * sizeof ( double );
+    ++NumberOfRecords;
+    return offset;
+}
+
+/********************************************************************************************/
+void SpillLog::read ( long long offset, std::vector< double > &values )
+{
+    std::lock_guard< std::mutex > lock ( LogMutex );
+    uint64_t n = 0;
+    if ( fseeko ( File , offset , SEEK_SET ) != 0 || std::fread ( &n , sizeof ( n ) , 1 , File ) != 1 )
+        throw std::runtime_error ( "Could not read from the spill log" );
+    values.resize ( n );
+    if ( n > 0 && std::fread ( values.data ( ) , sizeof ( double ) , n , File ) != n )
+        throw std::runtime_error ( "Could not read from the spill log" );
+}
+
+/********************************************************************************************/
+size_t SpillLog::getNumberOfRecords ( )
+{
+    std::lock_guard< std::mutex > lock ( LogMutex );
+    return NumberOfRecords;
+}
@@ -0,0 +1,54 @@
+#ifndef SPILLLOG_H_INCLUDED
+#define SPILLLOG_H_INCLUDED
+
+/**
+ * Class implementing an append only log of vectors of doubles in an anonymous temporary file. Used to move decision vectors
+ * of solutions out of memory when a memory ceiling is set. Records are stored as the number of values followed by the values.
+ * The file is removed when the log is destroyed. The functions may be called from several threads.
+ */
+
+//! C++ includes
+#include<vector>
+#include<cstdio>
+#include<mutex>
+
+class SpillLog{
+    private:
+        std::FILE *File;        //!< The temporary file
+        long long End;          //!< Offset of the end of the file
+        size_t NumberOfRecords; //!< Number of records appended
+        std::mutex LogMutex;    //!< Protects the members above
+
+    public:
+        /*!
+         * Default constructor. Opens the temporary file. Throws std::runtime_error if it cannot be created
+         */
+        SpillLog ( );
+
+        /*!
+         * Destructor. Closes and removes the temporary file
+         */
+        ~SpillLog ( );
+
+        SpillLog ( const SpillLog& ) = delete;
+        SpillLog& operator= ( const SpillLog& ) = delete;
+
+        /*! \brief Appends a vector to the log
+         * \param values constant reference to a vector of doubles. The values to store
+         * \return long long. Offset of the record, which is used to read it again
+         */
+        long long append ( const std::vector< double > &values );
+
+        /*! \brief Reads a record
+         * \param offset long long. Offset returned by append
+         * \param values reference to a vector of doubles. Holds the values of the record on return
+         */
+        void read ( long long offset, std::vector< double > &values );
+
+        /*!
+         * Returns the number of records appended
+         */
+        size_t getNumberOfRecords ( );
+};
+
+#endif // SPILLLOG_H_INCLUDED
@@ -0,0 +1,109 @@
+#include"ThreadBudget.h"
+
+#include<thread>
+#include<algorithm>
+
+/********************************************************************************************/
+ThreadBudget::ThreadBudget ( ):
+    Cores ( 0 ),
+    FreeCores ( 0 ),
+    ActiveWorkers ( 0 ),
+    ActiveRuns ( 0 ),
+    RunsStarted ( 0 ),
+    SmallBoxArea ( 100.0 )
+{}
+
+/********************************************************************************************/
+ThreadBudget& ThreadBudget::global ( )
+{
+    static ThreadBudget theBudget;
+    return theBudget;
+}
+
+/********************************************************************************************/
+void ThreadBudget::setCores ( int cores )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    if ( cores == 0 ) cores = std::max ( 1u , std::thread::hardware_concurrency ( ) );
+    if ( cores < 0 ) cores = 0;
+    // Keep the number of threads currently in use, so running solves can release them safely
+    FreeCores += cores - Cores;
+    Cores = cores;
+    BudgetCV.notify_all ( );
+}
+
+/********************************************************************************************/
+void ThreadBudget::setSmallBoxArea ( double area )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    SmallBoxArea = area;
+}
+
+/********************************************************************************************/
+bool ThreadBudget::isEnabled ( )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    return Cores > 0;
+}
+
+/********************************************************************************************/
+int ThreadBudget::getCores ( )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    return Cores;
+}
+
+/********************************************************************************************/
+void ThreadBudget::registerWorker ( )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    ++ActiveWorkers;
+}
+
+/********************************************************************************************/
+void ThreadBudget::unregisterWorker ( )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    if ( ActiveWorkers > 0 ) --ActiveWorkers;
+    BudgetCV.notify_all ( );
+}
+
+/********************************************************************************************/
+unsigned long ThreadBudget::beginRun ( )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    ++RunsStarted;
+    return ( ++ActiveRuns == 1 ) ? RunsStarted : 0;
+}
+
+/********************************************************************************************/
+bool ThreadBudget::endRun ( unsigned long ticket )
+{
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    if ( ActiveRuns > 0 ) --ActiveRuns;
+    // Alone at the start, and no run started since
+    return ticket != 0 && ticket == RunsStarted;
+}
+
+/********************************************************************************************/
+int ThreadBudget::acquire ( double boxArea )
+{
+    std::unique_lock< std::mutex > lock ( BudgetMutex );
+    if ( Cores <= 0 ) return 0; // Disabled. Let cplex decide
+    BudgetCV.wait ( lock , [this] { return FreeCores > 0 || Cores <= 0; } );
+    if ( Cores <= 0 ) return 0;
+
+    int share   = std::max ( 1 , Cores / std::max ( 1 , ActiveWorkers ) );
+    int threads = ( boxArea <= SmallBoxArea ) ? 1 : std::min ( share , FreeCores );
+    FreeCores  -= threads;
+    return threads;
+}
+
+/********************************************************************************************/
+void ThreadBudget::release ( int threads )
+{
+    if ( threads <= 0 ) return;
+    std::lock_guard< std::mutex > lock ( BudgetMutex );
+    FreeCores += threads;
+    BudgetCV.notify_all ( );
+}
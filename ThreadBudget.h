@@ -0,0 +1,101 @@
+#ifndef THREADBUDGET_H_INCLUDED
+#define THREADBUDGET_H_INCLUDED
+
+/**
+ * Class coordinating the number of threads cplex may use in each solve, when several tpm workers (triangles, slabs or instances)
+ * solve at the same time in one process. Without it, every solve uses all cores and the machine is oversubscribed.
+ * A single, process wide object is reached through ThreadBudget::global ( ). It is disabled until setCores is called.
+ */
+
+//! C++ includes
+#include<mutex>
+#include<condition_variable>
+#include<ctime>
+
+class ThreadBudget{
+    private:
+        int Cores;              //!< Total number of cores shared by all workers. Zero means the budget is disabled
+        int FreeCores;          //!< Cores not currently used by a solve
+        int ActiveWorkers;      //!< Number of registered workers
+        int ActiveRuns;         //!< Number of runs (calls of tpm::RUN) currently going on
+        unsigned long RunsStarted;  //!< Number of runs started so far
+        double SmallBoxArea;    //!< Boxes with an area (in objective space) up to this value are solved using a single thread
+        std::mutex BudgetMutex;             //!< Protects the members above
+        std::condition_variable BudgetCV;   //!< Signalled each time a solve releases its threads
+
+        /*!
+         * Default constructor. The budget is disabled until setCores is called
+         */
+        ThreadBudget ( );
+
+    public:
+        /*!
+         * Returns the process wide thread budget
+         */
+        static ThreadBudget& global ( );
+
+        /*! \brief Enables the budget
+         * \param cores integer. Number of cores shared by all workers. Zero means all cores of the machine. Negative disables the budget
+         */
+        void setCores ( int cores );
+
+        /*! \brief Sets the area below which boxes are solved using a single thread
+         * \param area double. Default is 100
+         */
+        void setSmallBoxArea ( double area );
+
+        /*!
+         * Returns true if setCores has been called with a non negative number
+         */
+        bool isEnabled ( );
+
+        /*!
+         * Returns the number of cores shared by the workers. Zero if the budget is disabled
+         */
+        int getCores ( );
+
+        /*!
+         * Registers a worker, that is a tpm object or a thread which will solve subproblems
+         */
+        void registerWorker ( );
+
+        /*!
+         * Unregisters a worker registered by registerWorker
+         */
+        void unregisterWorker ( );
+
+        /*! \brief Marks the start of a run, that is a call of tpm::RUN
+         * \return unsigned long. Ticket to hand to endRun. Zero if another run is going on already
+         */
+        unsigned long beginRun ( );
+
+        /*! \brief Marks the end of a run started by beginRun
+         *
+         * The cpu time of the process can only be credited to a run if no other run used the process at the same time.
+         * \param ticket unsigned long. The value returned by beginRun
+         * \return bool. True if no other run was going on at any time between beginRun and endRun
+         */
+        bool endRun ( unsigned long ticket );
+
+        /*! \brief Decides how many threads the next solve may use, and reserves them
+         *
+         * A solve gets a fair share of the cores, that is the number of cores divided by the number of active workers, but never more than are free.
+         * Solves of small boxes get a single thread, as they are over before more threads pay off. If no cores are free, the call waits until a solve releases its threads.
+         * \param boxArea double. Area of the box in objective space which is solved. Use IloInfinity if the solve is not restricted to a box
+         * \return int. The number of threads reserved. Must be handed back to release after the solve
+         */
+        int acquire ( double boxArea );
+
+        /*! \brief Releases threads reserved by acquire
+         * \param threads integer. The value returned by acquire
+         */
+        void release ( int threads );
+};
+
+/*!
+ * Returns the cpu time used by the process so far in seconds, summed over all threads
+ */
+inline
+double processCPUTime ( ) { return double ( std::clock ( ) ) / CLOCKS_PER_SEC; }
+
+#endif // THREADBUDGET_H_INCLUDED
@@ -0,0 +1,289 @@
+/**
+ * Micro benchmarks of the frontier maintenance in NDS and solution. No solver is needed.
+ *
+ * NDS::updateNDS, NDS::addToSupportedNDs, NDS::copySupToNonDom and solution::getVarValues are driven by synthetic frontiers with
+ * 10^2 to 10^6 points, inserted in random, convex, concave and adversarial order, with small and large decision vectors.
+ * updateNDS is also measured in integer mode, one point at a time (updateNDSInteger) and in batches of 1000 points (updateNDSBatch).
+ * The integer cases use the same points, doubled and rounded.
+ * For each case the time per operation, the number of heap allocations per operation and the peak resident memory are reported.
+ * Each case runs in its own child process, so the peak memory of one case does not hide that of the next.
+ *
+ * Compile from the root of the repository:
+ *      g++ -std=c++11 -O3 -I. bench/NDSBenchmark.cpp NDS.cpp solution.cpp SpillLog.cpp Logger.cpp -pthread -o NDSBenchmark
+ * Usage:
+ *      ./NDSBenchmark [--max n] [--budget seconds] [--payload-limit MB]
+ */
+
+//! C++ includes
+#include<iostream>
+#include<iomanip>
+#include<vector>
+#include<string>
+#include<random>
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<atomic>
+#include<cstdlib>
+#include<new>
+#include<sys/resource.h>
+#include<sys/wait.h>
+#include<unistd.h>
+
+//! My own C++ includes
+#include"NDS.h"
+#include"solution.h"
+
+/********************************************************************************************/
+/*      Counting allocations                                                                */
+/********************************************************************************************/
+static std::atomic< unsigned long > Allocations ( 0 ); // Number of calls to operator new
+
+// Every replaced operator new allocates through Allocate, and every replaced operator delete releases through Release, so the pairs always match.
+// Release is kept out of line, or gcc sees free called on a pointer from operator new where a delete is inlined, and warns (-Wmismatched-new-delete)
+#if defined ( __GNUC__ )
+#define BENCH_NOINLINE __attribute__ ( ( noinline ) )
+#else
+#define BENCH_NOINLINE
+#endif
+static void* Allocate ( std::size_t size ) noexcept
+{
+    Allocations.fetch_add ( 1 , std::memory_order_relaxed );
+    return std::malloc ( size ? size : 1 );
+}
+static BENCH_NOINLINE void Release ( void *p ) noexcept { std::free ( p ); }
+
+void* operator new ( std::size_t size )
+{
+    if ( void *p = Allocate ( size ) ) return p;
+    throw std::bad_alloc ( );
+}
+void* operator new[] ( std::size_t size ) { return operator new ( size ); }
+void* operator new ( std::size_t size, const std::nothrow_t& ) noexcept { return Allocate ( size ); }
+void* operator new[] ( std::size_t size, const std::nothrow_t& ) noexcept { return Allocate ( size ); }
+void operator delete ( void *p ) noexcept { Release ( p ); }
+void operator delete[] ( void *p ) noexcept { Release ( p ); }
+void operator delete ( void *p, std::size_t ) noexcept { Release ( p ); }
+void operator delete[] ( void *p, std::size_t ) noexcept { Release ( p ); }
+void operator delete ( void *p, const std::nothrow_t& ) noexcept { Release ( p ); }
+void operator delete[] ( void *p, const std::nothrow_t& ) noexcept { Release ( p ); }
+
+/********************************************************************************************/
+/*      Synthetic frontiers                                                                 */
+/********************************************************************************************/
+enum ORDER{ RANDOM, CONVEX, CONCAVE, ADVERSARIAL };
+static const char *OrderNames[] = { "random" , "convex" , "concave" , "adversarial" };
+
+struct CASE{
+    std::string Operation;  //!< Name of the operation measured
+    ORDER Order;            //!< Order the points are inserted in
+    size_t Points;          //!< Number of points
+    size_t Payload;         //!< Number of decision variables of each point
+}; //!< Struct describing a single benchmark case
+
+/*!
+ * Returns the outcome vectors of a synthetic instance. All points are mutually non-dominated, except in adversarial order
+ */
+std::vector< std::pair< double , double > > MakePoints ( ORDER order, size_t n )
+{
+    std::vector< std::pair< double , double > > points;
+    points.reserve ( n );
+    double N = double ( n );
+    for ( size_t i = 0; i < n; ++i )
+    {
+        double t = double ( i ) / N;
+        switch ( order )
+        {
+            case CONCAVE:   points.push_back ( std::make_pair ( double ( i ) , N * N * ( 1.0 - t * t ) ) ); break;
+            default:        points.push_back ( std::make_pair ( double ( i ) , N * N * ( 1.0 - t ) * ( 1.0 - t ) ) ); break;
+        }
+    }
+    if ( order == RANDOM )
+    {   // A convex frontier, inserted in random order
+        std::mt19937_64 generator ( 0 );
+        std::shuffle ( points.begin ( ) , points.end ( ) , generator );
+    }
+    else if ( order == ADVERSARIAL )
+    {   // The frontier grows at the end of the list, which is scanned in full for each insertion. Every tenth point is dominated, and every
+        // hundredth point dominates the ten points inserted before it, so runs of erasures are triggered as well
+        std::vector< std::pair< double , double > > hard;
+        hard.reserve ( n );
+        for ( size_t i = 0; hard.size ( ) < n; ++i )
+        {
+            hard.push_back ( points[i % n] );
+            if ( i % 10 == 9 && hard.size ( ) < n ) hard.push_back ( std::make_pair ( points[i % n].first + 0.5 , points[i % n].second + 0.5 ) );
+            if ( i % 100 == 99 && i >= 10 && hard.size ( ) < n ) hard.push_back ( std::make_pair ( points[i - 10].first - 0.5 , points[i].second - 0.5 ) );
+        }
+        points.swap ( hard );
+    }
+    return points;
+}
+
+/********************************************************************************************/
+/*      Running a case                                                                      */
+/********************************************************************************************/
+/*!
+ * Returns the peak resident memory of the process in megabytes
+ */
+double PeakMemory ( )
+{
+    rusage usage;
+    getrusage ( RUSAGE_SELF , &usage );
+    return usage.ru_maxrss / 1024.0; // ru_maxrss is in kilobytes on Linux
+}
+
+/*!
+ * Runs a case and prints a line with the results. Stops early when the time budget is used
+ */
+void RunCase ( const CASE &c, double budget )
+{
+    typedef std::chrono::steady_clock Clock;
+    std::vector< std::pair< double , double > > points = MakePoints ( c.Order , c.Points );
+    bool Integer = ( c.Operation == "updateNDSInteger" || c.Operation == "updateNDSBatch" );
+    if ( Integer )
+    {   // Doubling keeps the offsets of 0.5 of the adversarial order integral
+        for ( auto it = points.begin ( ); it != points.end ( ); ++it ) *it = std::make_pair ( 2.0 * it->first , std::round ( 2.0 * it->second ) );
+    }
+    std::vector< double > payload ( c.Payload , 1.0 );
+    std::vector< solution > solutions;
+    solutions.reserve ( points.size ( ) );
+    for ( auto it = points.begin ( ); it != points.end ( ); ++it ) solutions.push_back ( solution ( false , *it , payload ) );
+
+    NDS theNDS;
+    theNDS.setIntegerCoordinates ( Integer );
+    size_t done = 0;
+    bool complete = true;
+    unsigned long AllocationsBefore = 0;
+    Clock::time_point start;
+
+    auto OutOfTime = [&] ( ) { return ( done & 63 ) == 0 && std::chrono::duration< double > ( Clock::now ( ) - start ).count ( ) > budget; };
+
+    if ( c.Operation == "copySupToNonDom" || c.Operation == "getVarValues" )
+    {   // Build the supported set first. It is not measured
+        std::vector< solution > sorted = solutions;
+        std::sort ( sorted.begin ( ) , sorted.end ( ) , [] ( const solution &a, const solution &b ) { return a.getFirst ( ) < b.getFirst ( ); } );
+        std::list< solution > sup ( sorted.begin ( ) , sorted.end ( ) );
+        theNDS.createSupportedNDs ( sup );
+    }
+
+    AllocationsBefore = Allocations.load ( );
+    start = Clock::now ( );
+    if ( c.Operation == "updateNDS" || c.Operation == "updateNDSInteger" )
+    {
+        for ( ; done < solutions.size ( ); ++done )
+        {
+            if ( OutOfTime ( ) ) { complete = false; break; }
+            theNDS.updateNDS ( solutions[done] );
+        }
+    }
+    else if ( c.Operation == "updateNDSBatch" )
+    {
+        const size_t BatchSize = 1000;
+        std::vector< solution > batch;
+        while ( done < solutions.size ( ) )
+        {
+            if ( std::chrono::duration< double > ( Clock::now ( ) - start ).count ( ) > budget ) { complete = false; break; }
+            size_t end = std::min ( solutions.size ( ) , done + BatchSize );
+            batch.assign ( solutions.begin ( ) + done , solutions.begin ( ) + end );
+            theNDS.updateNDS ( batch );
+            done = end;
+        }
+    }
+    else if ( c.Operation == "addToSupportedNDs" )
+    {
+        for ( ; done < solutions.size ( ); ++done )
+        {
+            if ( OutOfTime ( ) ) { complete = false; break; }
+            theNDS.addToSupportedNDs ( solutions[done] );
+        }
+    }
+    else if ( c.Operation == "copySupToNonDom" )
+    {
+        theNDS.copySupToNonDom ( );
+        done = solutions.size ( );
+    }
+    else if ( c.Operation == "getVarValues" )
+    {
+        theNDS.copySupToNonDom ( );
+        AllocationsBefore = Allocations.load ( );
+        start = Clock::now ( );
+        std::vector< double > values;
+        double checksum = 0.0;
+        for ( auto it = theNDS.NDs.begin ( ); it != theNDS.NDs.end ( ); ++it, ++done )
+        {
+            it->getVarValues ( values );
+            checksum += values.empty ( ) ? 0.0 : values.back ( );
+        }
+        if ( checksum < 0.0 ) std::cout << ""; // Keep the loop from being optimised away
+    }
+    double seconds = std::chrono::duration< double > ( Clock::now ( ) - start ).count ( );
+    unsigned long allocations = Allocations.load ( ) - AllocationsBefore;
+    size_t frontier = ( c.Operation == "addToSupportedNDs" ) ? theNDS.SupNDs.size ( ) : theNDS.NDs.size ( );
+
+    std::cout   << std::left << std::setw ( 18 ) << c.Operation
+                << std::setw ( 12 ) << OrderNames[c.Order]
+                << std::right << std::setw ( 9 ) << c.Points
+                << std::setw ( 9 ) << c.Payload
+                << std::setw ( 10 ) << done
+                << std::setw ( 10 ) << frontier
+                << std::setw ( 14 ) << std::fixed << std::setprecision ( 1 ) << ( done > 0 ? 1e9 * seconds / done : 0.0 )
+                << std::setw ( 12 ) << std::setprecision ( 2 ) << ( done > 0 ? double ( allocations ) / done : 0.0 )
+                << std::setw ( 12 ) << std::setprecision ( 1 ) << PeakMemory ( )
+                << ( complete ? "" : "  (time budget)" ) << std::endl;
+}
+
+/********************************************************************************************/
+int main ( int argc, char** argv )
+{
+    size_t MaxPoints    = 1000000;  // Largest number of points
+    double Budget       = 20.0;     // Seconds a single case may run
+    double PayloadLimit = 1024.0;   // Cases whose decision vectors need more megabytes than this are skipped
+    for ( int a = 1; a < argc; ++a )
+    {
+        std::string arg = argv[a];
+        if ( arg == "--max" && a + 1 < argc ) MaxPoints = std::stoul ( argv[++a] );
+        else if ( arg == "--budget" && a + 1 < argc ) Budget = std::stod ( argv[++a] );
+        else if ( arg == "--payload-limit" && a + 1 < argc ) PayloadLimit = std::stod ( argv[++a] );
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--max n] [--budget seconds] [--payload-limit MB]\n";
+            return 1;
+        }
+    }
+
+    const char *Operations[] = { "updateNDS" , "updateNDSInteger" , "updateNDSBatch" , "addToSupportedNDs" , "copySupToNonDom" , "getVarValues" };
+    const size_t Payloads[]  = { 8 , 1024 };
+
+    std::cout   << std::left << std::setw ( 18 ) << "operation" << std::setw ( 12 ) << "order"
+                << std::right << std::setw ( 9 ) << "points" << std::setw ( 9 ) << "payload" << std::setw ( 10 ) << "done"
+                << std::setw ( 10 ) << "frontier" << std::setw ( 14 ) << "ns/op" << std::setw ( 12 ) << "allocs/op"
+                << std::setw ( 12 ) << "peak MB" << std::endl;
+    for ( const char *operation : Operations )
+    {
+        for ( int order = RANDOM; order <= ADVERSARIAL; ++order )
+        {
+            // Only the insertion functions depend on the order
+            if ( order != RANDOM && ( std::string ( operation ) == "copySupToNonDom" || std::string ( operation ) == "getVarValues" ) ) continue;
+            for ( size_t n = 100; n <= MaxPoints; n *= 10 )
+            {
+                for ( size_t payload : Payloads )
+                {
+                    // The points are held twice, by the input and by the frontier
+                    if ( 2.0 * n * payload * sizeof ( double ) / ( 1024.0 * 1024.0 ) > PayloadLimit ) continue;
+                    CASE c = { operation , ORDER ( order ) , n , payload };
+                    pid_t child = fork ( );
+                    if ( child == 0 )
+                    {
+                        RunCase ( c , Budget );
+                        std::exit ( 0 );
+                    }
+                    int status = 0;
+                    if ( child > 0 ) waitpid ( child , &status , 0 );
+                    if ( child < 0 || !WIFEXITED ( status ) || WEXITSTATUS ( status ) != 0 )
+                        std::cerr << "Case " << operation << " " << OrderNames[order] << " " << n << " " << payload << " failed\n";
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * Self checking driver for the parts of the algorithm which need no solver.
+ *
+ * BoxQueue: random sequences of pushes and pops, with a memory limit small enough to make the queue spill, are compared with a std::deque,
+ * both when taking from the front and from the back. Every box must come back in the order the deque gives.
+ * NDS: NDS::updateNDS ( vector ) is compared with inserting the same solutions one at a time, in integer mode and outside it, on random
+ * frontiers with repeated and dominated outcomes. The outcomes, the decision vectors and the hypervolume must be the same.
+ *
+ * Compile from the root of the repository:
+ *      g++ -std=c++11 -O2 -Wall -I. bench/SelfCheck.cpp NDS.cpp solution.cpp SpillLog.cpp Logger.cpp -pthread -o SelfCheck
+ * Usage:
+ *      ./SelfCheck [--rounds n]
+ * Returns zero if all checks pass. The first failure of each check is printed.
+ */
+
+//! C++ includes
+#include<iostream>
+#include<vector>
+#include<deque>
+#include<string>
+#include<random>
+#include<algorithm>
+#include<cmath>
+#include<cstdlib>
+
+//! My own C++ includes
+#include"BoxQueue.h"
+#include"NDS.h"
+#include"solution.h"
+
+struct BOX{
+    long long Id;   //!< Order in which the box was pushed
+    double Pad[3];  //!< Makes the box as large as the boxes of tpm
+}; //!< Struct used as the element of the queue
+
+/********************************************************************************************/
+/*      BoxQueue                                                                            */
+/********************************************************************************************/
+static bool CheckBoxQueue ( bool takeFront, size_t maxInMemory, unsigned seed )
+{
+    std::mt19937 g ( seed );
+    BoxQueue< BOX > queue ( takeFront , maxInMemory );
+    std::deque< long long > reference;
+    long long next = 0;
+
+    // Bursts of pushes and pops of random length, so the queue grows well beyond the limit and is emptied again
+    for ( int burst = 0; burst < 200; ++burst )
+    {
+        int pushes = g ( ) % ( 4 * ( maxInMemory + 2 ) ),
+            pops   = g ( ) % ( 4 * ( maxInMemory + 2 ) );
+        if ( burst % 50 == 49 ) pops = reference.size ( ) + pushes; // Empty the queue now and then
+        for ( int k = 0; k < pushes + pops; ++k )
+        {
+            bool push = ( k < pushes ) ? ( g ( ) % 3 != 0 ) : ( g ( ) % 3 == 0 );
+            if ( push || reference.empty ( ) )
+            {
+                BOX box = { next , { 0.0 , 0.0 , 0.0 } };
+                queue.push ( box );
+                reference.push_back ( next++ );
+            }
+            else
+            {
+                long long expected;
+                if ( takeFront )
+                {
+                    expected = reference.front ( );
+                    reference.pop_front ( );
+                }
+                else
+                {
+                    expected = reference.back ( );
+                    reference.pop_back ( );
+                }
+                long long got = queue.pop ( ).Id;
+                if ( got != expected )
+                {
+                    std::cerr << "BoxQueue front=" << takeFront << " limit=" << maxInMemory << " seed=" << seed
+                              << ": popped box " << got << ", expected " << expected << std::endl;
+                    return false;
+                }
+            }
+            if ( queue.size ( ) != reference.size ( ) || queue.empty ( ) != reference.empty ( ) )
+            {
+                std::cerr << "BoxQueue front=" << takeFront << " limit=" << maxInMemory << " seed=" << seed
+                          << ": size " << queue.size ( ) << ", expected " << reference.size ( ) << std::endl;
+                return false;
+            }
+        }
+    }
+    if ( maxInMemory > 0 && queue.getNumberOfSpilledBoxes ( ) == 0 )
+    {
+        std::cerr << "BoxQueue front=" << takeFront << " limit=" << maxInMemory << " seed=" << seed << ": the queue never spilled" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/********************************************************************************************/
+/*      NDS::updateNDS ( vector )                                                           */
+/********************************************************************************************/
+static bool CheckBatchInsertion ( bool integer, unsigned seed )
+{
+    std::mt19937 g ( seed );
+    int range = 20 + g ( ) % 200;
+    NDS single, batch;
+    single.setIntegerCoordinates ( integer );
+    batch.setIntegerCoordinates ( integer );
+    single.setReferencePoint ( range + 1.0 , range + 1.0 );
+    batch.setReferencePoint ( range + 1.0 , range + 1.0 );
+
+    long long tag = 0;
+    for ( int round = 0; round < 20; ++round )
+    {
+        // A batch of points, many of them repeated or dominated. Each decision vector tells which insertion it came from
+        std::vector< solution > sols;
+        int n = 1 + g ( ) % 50;
+        for ( int k = 0; k < n; ++k )
+        {
+            int a = g ( ) % range, b = g ( ) % range;
+            if ( g ( ) % 2 ) b = std::max ( 0 , range - 1 - a - int ( g ( ) % 5 ) ); // Near the line a + b = range, so many points are non--dominated
+            double noise = integer ? 0.001 * ( int ( g ( ) % 3 ) - 1 ) : 0.0;
+            sols.push_back ( solution ( false , std::make_pair ( a + noise , b - noise ) , std::vector< double > ( 2 , double ( tag++ ) ) ) );
+        }
+        for ( auto it = sols.begin ( ); it != sols.end ( ); ++it ) single.updateNDS ( *it );
+        batch.updateNDS ( sols );
+
+        if ( single.NDs.size ( ) != batch.NDs.size ( ) )
+        {
+            std::cerr << "updateNDS integer=" << integer << " seed=" << seed << " round=" << round << ": " << batch.NDs.size ( )
+                      << " solutions, expected " << single.NDs.size ( ) << std::endl;
+            return false;
+        }
+        std::vector< double > x, y;
+        for ( auto s = single.NDs.begin ( ), b = batch.NDs.begin ( ); s != single.NDs.end ( ); ++s, ++b )
+        {
+            s->getVarValues ( x );
+            b->getVarValues ( y );
+            if ( s->getFirst ( ) != b->getFirst ( ) || s->getSecond ( ) != b->getSecond ( ) || x != y )
+            {
+                std::cerr << "updateNDS integer=" << integer << " seed=" << seed << " round=" << round << ": (" << b->getFirst ( ) << "," << b->getSecond ( )
+                          << ") from insertion " << y[0] << ", expected (" << s->getFirst ( ) << "," << s->getSecond ( ) << ") from insertion " << x[0] << std::endl;
+                return false;
+            }
+        }
+        if ( std::fabs ( single.getHyperVolume ( ) - batch.getHyperVolume ( ) ) > 1e-6 )
+        {
+            std::cerr << "updateNDS integer=" << integer << " seed=" << seed << " round=" << round << ": hypervolume " << batch.getHyperVolume ( )
+                      << ", expected " << single.getHyperVolume ( ) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/********************************************************************************************/
+int main ( int argc, char *argv[] )
+{
+    unsigned rounds = 20;
+    for ( int a = 1; a < argc; ++a )
+    {
+        std::string arg = argv[a];
+        if ( arg == "--rounds" && a + 1 < argc ) rounds = std::atoi ( argv[++a] );
+    }
+
+    int failures = 0;
+    const size_t Limits[] = { 0 , 1 , 2 , 3 , 8 , 64 };
+    for ( bool takeFront : { true , false } )
+    {
+        for ( size_t limit : Limits )
+        {
+            bool ok = true;
+            for ( unsigned seed = 1; ok && seed <= rounds; ++seed ) ok = CheckBoxQueue ( takeFront , limit , seed );
+            if ( !ok ) ++failures;
+        }
+    }
+    std::cout << "BoxQueue " << ( failures == 0 ? "ok" : "FAILED" ) << std::endl;
+
+    int before = failures;
+    for ( bool integer : { true , false } )
+    {
+        bool ok = true;
+        for ( unsigned seed = 1; ok && seed <= rounds; ++seed ) ok = CheckBatchInsertion ( integer , seed );
+        if ( !ok ) ++failures;
+    }
+    std::cout << "updateNDS ( vector ) " << ( failures == before ? "ok" : "FAILED" ) << std::endl;
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
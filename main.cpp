@@ -1,8 +1,10 @@
 #include<iostream>  // Writing
 #include<vector>    // Gives us vectors
 #include<random>    // So we can make random data for the knapsack problem
+#include<string>    // Command line arguments
 #include"tpm.h"     // The two phase solver
 #include"CplexModel.h" // The CplexModel
+#include"BOKPHeuristic.h" // Heuristic for the knapsack problem
 
 
 
@@ -17,7 +19,42 @@ int main(int argc, char** argv)
         std::vector<int> w, // Weights of the items
                          p1,// Profit of items in first objective
                          p2;// Profit of items in second objective
+        int CoordinatorPort = 0,    // If positive, phase two is distributed to workers connecting on this port
+            WorkerPort      = 0,    // If positive, this process is a worker for the coordinator on WorkerHost:WorkerPort
+            Slabs           = 1;    // Number of slabs a triangle is split into when phase one finds few triangles
+        bool Reoptimise = false,    // If true, the instance is solved again with a larger capacity, starting from the first frontier
+             PhaseZero  = false,    // If true, a heuristic seeds the frontier before phase one
+             FixByRC    = false,    // If true, binaries are fixed by reduced costs in each triangle of phase two
+             Integer    = true;     // If false, the frontier compares outcomes with a tolerance instead of exactly as integers
+        std::string WorkerHost,
+                    Engine = "psm",         // Phase two engine: psm, ranking, epsilon or balanced
+                    ProfileFile,            // If not empty, the parameter profiles of the subproblem classes are read from this file
+                    ListenAddress = "127.0.0.1"; // Interface the coordinator listens on. Only local workers can connect by default
 
+        /*================================================================*/
+        /*      Command line: --coordinator port, --listen address,       */
+        /*      --worker host port                                        */
+        /*      --slabs k, --reoptimise, --phase-zero, --engine name      */
+        /*      --rc-fixing, --profiles file and --no-integer             */
+        /*================================================================*/
+        for ( int a = 1; a < argc; ++a )
+        {
+            std::string arg = argv[a];
+            if ( arg == "--coordinator" && a + 1 < argc ) CoordinatorPort = std::stoi ( argv[++a] );
+            else if ( arg == "--listen" && a + 1 < argc ) ListenAddress = argv[++a];
+            else if ( arg == "--slabs" && a + 1 < argc ) Slabs = std::stoi ( argv[++a] );
+            else if ( arg == "--reoptimise" ) Reoptimise = true;
+            else if ( arg == "--phase-zero" ) PhaseZero = true;
+            else if ( arg == "--engine" && a + 1 < argc ) Engine = argv[++a];
+            else if ( arg == "--rc-fixing" ) FixByRC = true;
+            else if ( arg == "--no-integer" ) Integer = false;
+            else if ( arg == "--profiles" && a + 1 < argc ) ProfileFile = argv[++a];
+            else if ( arg == "--worker" && a + 2 < argc )
+            {
+                WorkerHost = argv[++a];
+                WorkerPort = std::stoi ( argv[++a] );
+            }
+        }
 
         /*================================================================*/
         /*          Generating random data for KP-problem                 */
@@ -48,11 +85,36 @@ int main(int argc, char** argv)
         /*================================================================*/
         /*          Run the two phase method                              */
         /*================================================================*/
-        tpm twoPhaseMethod = tpm ( ); // Construct the object
+        tpm twoPhaseMethod; // Construct the object
+        // A worker builds the same instance as the coordinator (the seed is fixed), and solves the boxes it is handed
+        if ( WorkerPort > 0 ) return twoPhaseMethod.RUNWorker ( theModel , WorkerHost , WorkerPort );
+        twoPhaseMethod.distributePhaseTwo ( CoordinatorPort , ListenAddress );
+        // Each slab builds its own copy of the instance from the data recorded by buildBOKP
+        twoPhaseMethod.setSlabs ( Slabs );
+        twoPhaseMethod.detectTotallyUnimodular ( ); // The knapsack constraint is not totally unimodular, so phase one solves MIPs
+        if ( PhaseZero )
+        {   // The greedy heuristic for the knapsack problem and a few short weighted solves
+            twoPhaseMethod.setPhaseZeroHeuristic ( BOKPHeuristic ( n , cap , w , p1 , p2 ) );
+            twoPhaseMethod.setPhaseZero ( 5 , 0.5 );
+        }
+        if ( Engine == "ranking" ) twoPhaseMethod.setPhaseTwoEngine ( ENGINE_RANKING );
+        else if ( Engine == "epsilon" ) twoPhaseMethod.setPhaseTwoEngine ( ENGINE_EPSILON );
+        else if ( Engine == "balanced" ) twoPhaseMethod.setPhaseTwoEngine ( ENGINE_BALANCED_BOX );
+        if ( FixByRC ) twoPhaseMethod.useReducedCostFixing ( );
+        twoPhaseMethod.setIntegerOutcomes ( Integer );
+        if ( !ProfileFile.empty ( ) && !twoPhaseMethod.loadProfiles ( ProfileFile ) ) return 1;
         twoPhaseMethod.printProgress(); // Let the algorithm print the progress of phase two to the screen
         const std::string FileName = "TheOutputFile.txt"; // Choose a file name for printing results
         twoPhaseMethod.printToFile( FileName ); // Set the file name in tpm
         twoPhaseMethod.RUN ( theModel );
+        if ( Reoptimise )
+        {   // Change the capacity a little, and solve again starting from the frontier just found
+            std::list< solution > Previous = twoPhaseMethod.getNonDominatedSet ( );
+            theModel.reset ( );
+            theModel.buildBOKP ( n , cap + 10 , w , p1, p2 );
+            twoPhaseMethod.setPreviousFrontier ( Previous );
+            twoPhaseMethod.RUN ( theModel );
+        }
 
         /*================================================================*/
         /*          Print statistics                                      */
@@ -60,11 +122,28 @@ int main(int argc, char** argv)
         testStatistics* TS = twoPhaseMethod.getTestStatistics ( );
         std::cout   << "Number of branching nodes        : " << TS->NumberOfBranchingNodes << "\n"
                     << "Number of phase one solutions    : " << TS->NumberOfPhaseOneSolutions << "\n"
+                    << "Phase one solved as LPs          : " << ( TS->PhaseOneLP ? "yes" : "no" ) << "\n"
                     << "Number of Phase two solutions    : " << TS->NumberOfPhaseTwoSolutions << "\n"
                     << "Total number of solutions        : " << TS->TotalNumberOfSolutions << "\n"
+                    << "Time used in phase zero (seconds): " << TS->PhaseZeroTime << "\n"
                     << "Time used in phase one (seconds) : " << TS->PhaseOneTime << "\n"
                     << "Time used in phase two (seconds) : " << TS->PhaseTwoTime << "\n"
-                    << "Total time consumption (sedonds) : " << TS->TotalTime << std::endl;
+                    << "Total time consumption (sedonds) : " << TS->TotalTime << "\n"
+                    << "Number of cplex solves           : " << TS->NumberOfSolves << "\n"
+                    << "Threads per solve                : " << TS->ThreadsPerSolve << "\n"
+                    << "CPU utilisation                  : " << TS->CPUUtilisation << "\n"
+                    << "Triangles pruned by LP bound     : " << TS->NumberOfPrunedTriangles << "\n"
+                    << "Triangles solved by PSM/ranking  : " << TS->NumberOfPSMTriangles << "/" << TS->NumberOfRankingTriangles << "\n"
+                    << "Slabs searched in parallel       : " << TS->NumberOfSlabs << "\n"
+                    << "Boxes/solutions spilled to disk  : " << TS->NumberOfSpilledBoxes << "/" << TS->NumberOfSpilledSolutions << "\n"
+                    << "Reused solutions/repair starts   : " << TS->NumberOfReusedSolutions << "/" << TS->NumberOfRepairStarts << "\n"
+                    << "Solutions found by phase zero    : " << TS->NumberOfPhaseZeroSolutions << "\n"
+                    << "Variables fixed by reduced costs : " << TS->NumberOfFixedVariables << "\n"
+                    << "Seconds in lex/wsum/box/rank/LP  : " << TS->SubproblemTime[SUBPROBLEM_LEXICOGRAPHIC] << "/" << TS->SubproblemTime[SUBPROBLEM_WEIGHTED] << "/"
+                                                              << TS->SubproblemTime[SUBPROBLEM_BOX] << "/" << TS->SubproblemTime[SUBPROBLEM_RANKING] << "/"
+                                                              << TS->SubproblemTime[SUBPROBLEM_LP] << "\n"
+                    << "Hypervolume of the frontier      : " << TS->HyperVolume << "\n"
+                    << "Unexplored area                  : " << TS->UnexploredArea << std::endl;
 
         // Return 0, as all seems to be in good order
         return 0;
@@ -1,21 +1,23 @@
 #include"solution.h"
 /************************************************************************************/
-solution::solution():supported(false),p(std::pair<double,double>(0.0,0.0)){}
+solution::solution():supported(false),p(std::pair<double,double>(0.0,0.0)),Offset(-1){}
 
 /************************************************************************************/
-solution::solution ( bool supported ):supported(supported){}
+solution::solution ( bool supported ):supported(supported),Offset(-1){}
 
 /************************************************************************************/
-solution::solution ( bool supported, const std::pair<double,double>& p): supported(supported), p(p) {}
+solution::solution ( bool supported, const std::pair<double,double>& p): supported(supported), p(p), Offset(-1) {}
 
 /************************************************************************************/
-solution::solution ( bool supported, const std::pair<double,double>& p, const std::vector<double>& var ): supported(supported), p(p), var(var) {}
+solution::solution ( bool supported, const std::pair<double,double>& p, const std::vector<double>& var ): supported(supported), p(p), var(var), Offset(-1) {}
 
 /************************************************************************************/
 void solution::getVarValues ( std::vector<double> &VarVector ) const {
     try{
         if ( !VarVector.empty() ) VarVector.clear(); // Clear the incomning vector to be sure
 
+        if ( Log ) { Log->read ( Offset , VarVector ); return; } // The values have been spilled, so read them from the log
+
         if ( var.empty ( ) ) return; // If var-vector is empty, just return
         else for( auto it= var.begin(); it!=var.end(); ++it ) VarVector.push_back( *it ); // Else, copy the content of var to VarVector
 
@@ -23,3 +25,11 @@ void solution::getVarValues ( std::vector<double> &VarVector ) const {
         std::cerr << "Exception in getVarVector in the solution class : " << e.what() << std::endl;
     }
 }
+
+/************************************************************************************/
+void solution::spill ( const std::shared_ptr< SpillLog > &log ) {
+    if ( Log || var.empty ( ) ) return; // Already spilled, or nothing to spill
+    Offset = log->append ( var );
+    Log = log;
+    std::vector<double> ( ).swap ( var ); // Free the memory
+}
@@ -4,12 +4,18 @@
 #include<vector>
 #include<iostream>
 #include<stdexcept>
+#include<memory>
+#include<cmath>
+
+#include"SpillLog.h"
 
 class solution{
     private:
         bool supported;     //! Flag indicating if a point is supported
         std::pair<double,double> p; //! pair representing the outcome vector
         std::vector<double> var;    //! vector holding the variable value of the solution
+        std::shared_ptr< SpillLog > Log;    //! Log holding the variable values when they have been spilled. Null while they are in memory
+        long long Offset;                   //! Offset of the variable values in Log
     public:
         solution ( );   //! Empty constructor
         solution ( bool supported );    //! Constructor only setting the support-flag
@@ -37,11 +43,35 @@ class solution{
         inline
         double getSecond ( ) const { return p.second; }
 
+        /*!
+         * Function rounding both objective function values to the nearest integers. Used by NDS in integer mode
+         */
+        inline
+        void roundOutcome ( ) { p.first = std::round ( p.first ); p.second = std::round ( p.second ); }
+
         /*!
          * Function returning the vector of variable values
          * \param VarVector vector of doubles. Equals var on output
          */
         void getVarValues( std::vector<double> &VarVector ) const;
+
+        /*!
+         * Function returning the number of bytes of memory used by the vector of variable values
+         */
+        inline
+        size_t getResidentBytes ( ) const { return var.capacity ( ) * sizeof ( double ); }
+
+        /*!
+         * Function returning true if the variable values have been moved to a spill log
+         */
+        inline
+        bool isSpilled ( ) const { return Log != nullptr; }
+
+        /*!
+         * Function moving the variable values to a spill log and freeing their memory. getVarValues reads them back from the log
+         * \param log shared pointer to a SpillLog. The log to append the values to
+         */
+        void spill ( const std::shared_ptr< SpillLog > &log );
 };
 
 #endif // SOLUTION_H_INCLUDED
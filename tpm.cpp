@@ -1,5 +1,15 @@
 #include"tpm.h"
 
+#include<thread>
+#include<cmath>
+#include<queue>
+#include<memory>
+#include<sstream>
+#include<fstream>
+#include<unordered_map>
+#include<poll.h>
+#include<unistd.h>
+
 using namespace std::chrono;
 
 /********************************************************************************************/
@@ -18,11 +28,34 @@ tpm::tpm ( ):
     myZero ( 0.0001 ),
     myOne ( 0.9999 ),
     myTol ( 0.001 ),
-    PrintProgress( false ),
     totalTime ( 1e+75 ),
     PrintToFile ( false ),
-    DoRanking ( false ),
-    TakeFront ( true )
+    Engine ( ENGINE_PSM ),
+    TakeFront ( true ),
+    Threads ( 0 ),
+    UseLPBound ( false ),
+    Epsilon ( 0.0 ),
+    RelativeEpsilon ( false ),
+    TimedOut ( false ),
+    RepresentationSize ( 0 ),
+    RepresentationBudget ( 0 ),
+    UnexploredArea ( 0.0 ),
+    AdaptiveStrategy ( false ),
+    RankingIterations ( 0 ),
+    PointsPerWidth ( 0.5 ),
+    AsyncPostProcessing ( true ),
+    CoordinatorPort ( 0 ),
+    CoordinatorAddress ( "127.0.0.1" ),
+    WorkerWait ( 60.0 ),
+    Slabs ( 1 ),
+    MemoryCeiling ( 0 ),
+    TotallyUnimodular ( false ),
+    DetectTotallyUnimodular ( false ),
+    PhaseZeroWeights ( 0 ),
+    PhaseZeroSeconds ( 1.0 ),
+    ReducedCostFixing ( false ),
+    IntegerOutcomes ( true ),
+    Profiles ( NUMBER_OF_SUBPROBLEM_CLASSES )
 {
     theStatistics = new testStatistics;
 }
@@ -35,55 +68,143 @@ tpm::~tpm ( ){
 /********************************************************************************************/
 int tpm::RUN( CplexModel &theModel )
 {
+    MODELSTATE InitialState;
     try{
         /*================================================*/
-        /*      Initialize test statistics                */
+        /*      Initialize test statistics and frontier   */
         /*================================================*/
-        theStatistics->TotalTime =
-        theStatistics->PhaseOneTime =
-        theStatistics->PhaseTwoTime =
-        theStatistics->NumberOfBranchingNodes =
-        theStatistics->TotalNumberOfSolutions =
-        theStatistics->NumberOfPhaseOneSolutions =
-        theStatistics->NumberOfPhaseTwoSolutions = 0;
+        reset ( );
+        ThreadBudget::global ( ).registerWorker ( );
+        // Unregisters exactly once, after the output is written or when RUN leaves by an exception
+        struct WORKERGUARD{ ~WORKERGUARD ( ) { ThreadBudget::global ( ).unregisterWorker ( ); } } WorkerGuard;
+        unsigned long RunTicket = ThreadBudget::global ( ).beginRun ( );
+        // The run starts here for the time limit, the total time and the cpu utilisation alike
+        StartTime = CPUclock::now ( );
+        double StartCPUTime = processCPUTime ( );
+
+        // Half of the memory ceiling is used by the decision vectors of the frontier, and half by the pending boxes
+        NonDomSet.setMemoryCeiling ( MemoryCeiling / 2 );
+        NonDomSet.setIntegerCoordinates ( IntegerOutcomes );
+
+        // The model may have been changed directly since the last run. Make sure the cached state of the fast modification functions is correct
+        theModel.synchronize ( );
+
+        // Remember what the model looked like, so it can be restored when we are done
+        SaveModelState ( theModel , InitialState );
 
-        // Tell cplex not to reduce the problem!
-        theModel.cplex.setParam( IloCplex::Reduce , 0);
+        // Check the frontier of an earlier run against the model. Its supported solutions become MIP starts of phase one
+        if ( !PreviousFrontier.empty ( ) ) SeedFrontier ( theModel , PreviousFrontier , true );
+
+        // Tell cplex how many threads it may use. The other parameters are set for each subproblem by its profile
+        theModel.setParameter ( IloCplex::Param::Threads , Threads );
+
+        /*================================================*/
+        /*      Phase zero starts here                    */
+        /*================================================*/
+        if ( PhaseZeroWeights > 0 || PhaseZeroHeuristic )
+        {
+            auto Start_0 = CPUclock::now ( );
+            RunPhaseZero ( theModel );
+            theStatistics->PhaseZeroTime = duration_cast< duration < double > > ( CPUclock::now ( ) - Start_0 ).count ( );
+            TPM_LOG ( LOG_INFO , "phase_zero time=" << theStatistics->PhaseZeroTime << " solutions=" << theStatistics->NumberOfPhaseZeroSolutions );
+        }
 
         /*================================================*/
         /*      Phase one starts here                     */
         /*================================================*/
         auto Start_1 = CPUclock::now ( );
-        StartTime = Start_1;
-        RunPhaseOne ( theModel );
+        // A totally unimodular model has integral LP extreme points, so phase one needs no MIP solves
+        if ( TotallyUnimodular || ( DetectTotallyUnimodular && IsTotallyUnimodular ( theModel ) ) )
+        {
+            theStatistics->PhaseOneLP = RunPhaseOneLP ( theModel );
+        }
+        if ( !theStatistics->PhaseOneLP ) RunPhaseOne ( theModel );
+        {   // The MIP starts have served their purpose
+            int added = theModel.cplex.getNMIPStarts ( ) - InitialState.MIPStarts;
+            if ( added > 0 ) theModel.cplex.deleteMIPStarts ( InitialState.MIPStarts , added );
+        }
+        if ( !Seeds.empty ( ) )
+        {   // Put the feasible solutions of the earlier run and of phase zero on the frontier
+            NonDomSet.updateNDS ( std::vector< solution > ( Seeds.begin ( ) , Seeds.end ( ) ) );
+            TPM_LOG ( LOG_INFO , "seeds reused=" << theStatistics->NumberOfReusedSolutions << " repair_starts=" << theStatistics->NumberOfRepairStarts
+                                 << " phase_zero=" << theStatistics->NumberOfPhaseZeroSolutions << " frontier=" << NonDomSet.NDs.size ( ) );
+        }
         auto End_1 = CPUclock::now ( );
         // Gather statistics
         theStatistics->PhaseOneTime = duration_cast< duration < double > > (End_1 -Start_1 ).count ( );
         // Print out time consumption to the screen
-        std::cout << "Phase one time : " << theStatistics->PhaseOneTime << " seconds\n";
+        TPM_LOG ( LOG_INFO , "phase_one time=" << theStatistics->PhaseOneTime << " solutions=" << theStatistics->NumberOfPhaseOneSolutions );
 
 
         /*================================================*/
         /*      Phase two starts here                     */
         /*================================================*/
         auto Start_2 = CPUclock::now ( );
-        if ( DoRanking )
+        PhaseTwoStartTime = Start_2;
+        // Updating the frontier and printing overlaps the next solve
+        if ( AsyncPostProcessing ) Pipeline.start ( );
+        if ( UseLPBound && NonDomSet.NDs.size ( ) > 1 )
+        {
+            // Compute the LP relaxation lower bound set used to discard triangles and boxes
+            std::list< solution > LPExtremes;
+            if ( theStatistics->PhaseOneLP ) SetLPFacets ( NonDomSet.SupNDs ); // Phase one computed it already
+            else if ( ComputeLPBoundSet ( theModel , LPExtremes , false ) ) SetLPFacets ( LPExtremes );
+            theStatistics->NumberOfLPBoundPoints = LPExtremePoints.size ( );
+        }
+        if ( RepresentationSize > 0 )
+        {
+            // Representation of the frontier by well spread outcomes
+            RunPhaseTwoRepresentation ( theModel );
+        }
+        else if ( CoordinatorPort > 0 )
+        {
+            // Perpendicular search method with the boxes solved by worker processes
+            RunPhaseTwoDistributed ( theModel );
+        }
+        else if ( AdaptiveStrategy )
+        {
+            // Perpendicular search method or ranking, chosen per triangle
+            RunPhaseTwoAdaptive ( theModel );
+        }
+        else if ( Engine == ENGINE_RANKING )
         {
             // Ranking based two phase method
             RunPhaseTwoRanking( theModel );
         }
         else
         {
-            // Perpendicular search method based TPM
+            // Perpendicular search method (or epsilon constraint) based TPM
             RunPhaseTwo ( theModel );
         }
+        Pipeline.stop ( );
         auto End_2 = CPUclock::now ( );
 
         // Print out time consumption to the screen
         theStatistics->PhaseTwoTime    = duration_cast< duration < double > > (End_2 -Start_2 ).count ( );
-        theStatistics->TotalTime       = theStatistics->PhaseOneTime + theStatistics->PhaseTwoTime;
-        std::cout << "Phase two time : " << theStatistics->PhaseTwoTime << " seconds\n";
-        std::cout << "Total time     : " << theStatistics->TotalTime    << " seconds\n";
+        theStatistics->TotalTime       = duration_cast< duration < double > > ( End_2 - StartTime ).count ( ); // Includes checking the previous frontier
+        if ( theStatistics->NumberOfSolves > 0 ) theStatistics->ThreadsPerSolve /= theStatistics->NumberOfSolves;
+        {   // Cpu time of the process over wall time times the cores available to it. The cpu time of cplex threads cannot be told apart
+            // by run, so it is only reported when no other run shared the process
+            double CPUTime = processCPUTime ( ) - StartCPUTime;
+            int cores = ThreadBudget::global ( ).getCores ( );
+            if ( cores <= 0 ) cores = std::max ( 1u , std::thread::hardware_concurrency ( ) );
+            double wall = theStatistics->TotalTime;
+            bool Alone = ThreadBudget::global ( ).endRun ( RunTicket );
+            if ( wall > 0.0 && Alone ) theStatistics->CPUUtilisation = CPUTime / ( wall * cores );
+        }
+        // Unless the time limit stopped the algorithm, every non--dominated outcome is dominated by the frontier up to the approximation factor.
+        // A representation stops after a number of outcomes on purpose, so it certifies nothing
+        theStatistics->ApproximationCertified = !TimedOut && RepresentationSize == 0;
+        theStatistics->HyperVolume = NonDomSet.getHyperVolume ( );
+        theStatistics->UnexploredArea = UnexploredArea;
+        theStatistics->NumberOfSpilledSolutions = NonDomSet.getNumberOfSpilledSolutions ( );
+        TPM_LOG ( LOG_INFO , "phase_two time=" << theStatistics->PhaseTwoTime << " solutions=" << theStatistics->NumberOfPhaseTwoSolutions );
+        TPM_LOG ( LOG_INFO , "total time=" << theStatistics->TotalTime << " solutions=" << theStatistics->TotalNumberOfSolutions );
+        for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub )
+        {
+            TPM_LOG ( LOG_INFO , "subproblems class=" << SubproblemClassName ( SubproblemClass ( sub ) ) << " solves=" << theStatistics->SubproblemSolves[sub]
+                                 << " time=" << theStatistics->SubproblemTime[sub] );
+        }
 
 
 
@@ -127,10 +248,14 @@ int tpm::RUN( CplexModel &theModel )
             OutputFile.close ( );
 
         }
+        RestoreModelState ( theModel , InitialState );
+        Logger::global ( ).flush ( ); // Everything logged by the run is written before RUN returns
         return 0;
     }
     catch ( int i )
     {
+        RestoreModelState ( theModel , InitialState );
+        Logger::global ( ).flush ( );
         if ( 101 == 1 )
         {
             std::cerr << "Could not open the specified file for printing!\n";
@@ -148,6 +273,427 @@ int tpm::RUN( CplexModel &theModel )
     }
 }
 
+/********************************************************************************************/
+void tpm::reset ( )
+{
+    NonDomSet.clear ( );
+    LPFacets.clear ( );
+
+    theStatistics->TotalTime =
+    theStatistics->PhaseZeroTime =
+    theStatistics->PhaseOneTime =
+    theStatistics->PhaseTwoTime =
+    theStatistics->NumberOfBranchingNodes =
+    theStatistics->TotalNumberOfSolutions =
+    theStatistics->NumberOfPhaseOneSolutions =
+    theStatistics->NumberOfPhaseTwoSolutions =
+    theStatistics->NumberOfSolves =
+    theStatistics->NumberOfLPBoundPoints =
+    theStatistics->NumberOfPrunedTriangles =
+    theStatistics->NumberOfPrunedBoxes =
+    theStatistics->NumberOfPSMTriangles =
+    theStatistics->NumberOfRankingTriangles =
+    theStatistics->NumberOfSlabs =
+    theStatistics->NumberOfSpilledBoxes =
+    theStatistics->NumberOfSpilledSolutions =
+    theStatistics->NumberOfReusedSolutions =
+    theStatistics->NumberOfRepairStarts =
+    theStatistics->NumberOfPhaseZeroSolutions =
+    theStatistics->NumberOfFixedVariables = 0;
+    for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub )
+    {
+        theStatistics->SubproblemTime[sub] = 0.0;
+        theStatistics->SubproblemSolves[sub] = 0;
+    }
+    theStatistics->ThreadsPerSolve =
+    theStatistics->CPUUtilisation = 0.0;
+    theStatistics->ApproximationEpsilon = Epsilon;
+    theStatistics->ApproximationRelative = RelativeEpsilon;
+    theStatistics->ApproximationCertified =
+    theStatistics->PhaseOneLP = false;
+    theStatistics->HyperVolume =
+    theStatistics->UnexploredArea = 0.0;
+    TimedOut = false;
+    UnexploredArea = 0.0;
+    RankingIterations = 0;
+    LPExtremePoints.clear ( );
+    SlabData.reset ( );
+    Seeds.clear ( );
+}
+
+/********************************************************************************************/
+bool tpm::ComputeLPBoundSet ( CplexModel &theModel, std::list< solution > &Extremes, bool KeepVarValues )
+{
+    Extremes.clear ( );
+    try
+    {
+        int maxiterations = 10000;      // Safeguard against cycling due to numerical trouble. Segments not yet verified are not facets, so stopping early gives no bound set
+        double  lambda1,                // Weight for the first objective
+                lambda2,                // Weight for the second objective
+                f1UB = theModel.f1.getUB ( ),  // Upper bounds on f1 and f2 when we start
+                f2UB = theModel.f2.getUB ( );
+        std::pair<double,double> p;     // Pair used to store the outcome vector of a solution
+        std::vector<double> VarVals;    // Vector used to hold the current solution
+        IloNumArray vals ( theModel.env );
+
+        // Retrieves the current LP solution
+        auto CurrentSolution = [&] ( )
+        {
+            p.first     = theModel.cplex.getValue ( theModel.f1 );
+            p.second    = theModel.cplex.getValue ( theModel.f2 );
+            VarVals.clear ( );
+            if ( KeepVarValues )
+            {
+                theModel.cplex.getValues ( vals , theModel.AllVars );
+                for ( IloInt s = 0; s < vals.getSize ( ); ++s ) VarVals.push_back ( vals[s] );
+            }
+            return solution ( true , p , VarVals );
+        };
+
+        // Gives up, leaving the model as it was found
+        auto Abandon = [&] ( )
+        {
+            theModel.setF1UB ( f1UB );
+            theModel.setF2UB ( f2UB );
+            theModel.unrelax ( );
+            vals.end ( );
+            Extremes.clear ( );
+            return false;
+        };
+
+        // The optimal value of an objective, used as a bound when the other objective is minimised. A slack is safe for the bound set, as it only
+        // lowers the bound. The end points kept as phase one solutions must be exact, or the simplex method slides along the next edge of the frontier
+        auto Optimum = [&] ( const IloNumVar &f )
+        {
+            double value = theModel.cplex.getValue ( f );
+            if ( !KeepVarValues ) return value + myTol;
+            return ( std::fabs ( value - std::round ( value ) ) < myZero ) ? std::round ( value ) : value;
+        };
+
+        theModel.relax ( );
+
+        /*==========================================================*/
+        /*      Lexicographic minimizers of (f1,f2) and (f2,f1)     */
+        /*==========================================================*/
+        theModel.setWeights ( 1.0 , 0.0 );
+        if ( !Solve ( theModel , IloInfinity , SUBPROBLEM_LP ) ) return Abandon ( );
+        theModel.setF1UB ( Optimum ( theModel.f1 ) );
+        theModel.setWeights ( 0.0 , 1.0 );
+        if ( !Solve ( theModel , IloInfinity , SUBPROBLEM_LP ) )
+        {
+            if ( KeepVarValues ) return Abandon ( );
+            throw std::runtime_error ( "Could not solve the LP relaxation in order to find the upper left point" );
+        }
+        Extremes.push_back ( CurrentSolution ( ) );
+        theModel.setF1UB ( f1UB );
+
+        if ( !Solve ( theModel , IloInfinity , SUBPROBLEM_LP ) ) throw std::runtime_error ( "Could not solve the LP relaxation in order to find the lower right point" );
+        theModel.setF2UB ( Optimum ( theModel.f2 ) );
+        theModel.setWeights ( 1.0 , 0.0 );
+        if ( !Solve ( theModel , IloInfinity , SUBPROBLEM_LP ) )
+        {
+            if ( KeepVarValues ) return Abandon ( );
+            throw std::runtime_error ( "Could not solve the LP relaxation in order to find the lower right point" );
+        }
+        solution LowerRight = CurrentSolution ( );
+        theModel.setF2UB ( f2UB );
+        if ( LowerRight.getFirst ( ) > Extremes.front ( ).getFirst ( ) + myTol ) Extremes.push_back ( LowerRight );
+
+        /*==========================================================*/
+        /*      NISE iterations between consecutive points          */
+        /*==========================================================*/
+        auto PlusIt = Extremes.begin ( );
+        for ( int iteration = 1; iteration < maxiterations && std::next ( PlusIt ) != Extremes.end ( ); ++iteration )
+        {
+            auto MinusIt = std::next ( PlusIt );
+            lambda1 = PlusIt->getSecond ( ) - MinusIt->getSecond ( );
+            lambda2 = MinusIt->getFirst ( ) - PlusIt->getFirst ( );
+            theModel.setWeights ( lambda1 , lambda2 );
+            if ( !Solve ( theModel , IloInfinity , SUBPROBLEM_LP ) ) throw std::runtime_error ( "Could not solve the LP relaxation in the NISE iterations" );
+
+            if ( theModel.cplex.getObjValue ( ) <= lambda1*PlusIt->getFirst ( ) + lambda2*PlusIt->getSecond ( ) - myTol )
+            {   // A new extreme point between PlusIt and MinusIt
+                Extremes.insert ( MinusIt , CurrentSolution ( ) );
+            }
+            else ++PlusIt; // The segment between PlusIt and MinusIt is a facet
+        }
+        bool Complete = ( std::next ( PlusIt ) == Extremes.end ( ) );
+
+        theModel.unrelax ( );
+        vals.end ( );
+        if ( !Complete )
+        {   // Some segments were never verified, and could cut off feasible outcomes
+            TPM_LOG ( LOG_WARNING , "lp_bound_set complete=0 iterations=" << maxiterations << " extreme_points=" << Extremes.size ( ) );
+            Extremes.clear ( );
+        }
+        return Complete;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in ComputeLPBoundSet in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in ComputeLPBoundSet in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::SetLPFacets ( const std::list< solution > &Extremes )
+{
+    LPFacets.clear ( );
+    LPExtremePoints.clear ( );
+    if ( Extremes.empty ( ) ) return;
+    for ( auto it = Extremes.begin ( ); it != Extremes.end ( ); ++it ) LPExtremePoints.push_back ( std::make_pair ( it->getFirst ( ) , it->getSecond ( ) ) );
+
+    // The ideal point of the LP relaxation bounds both objectives from below
+    LPFacets.push_back ( { 1.0 , 0.0 , Extremes.front ( ).getFirst ( ) } );
+    LPFacets.push_back ( { 0.0 , 1.0 , Extremes.back ( ).getSecond ( ) } );
+
+    // Each segment between consecutive extreme points gives a facet
+    for ( auto it = Extremes.begin ( ); std::next ( it ) != Extremes.end ( ); ++it )
+    {
+        LPFACET facet;
+        facet.l1    = it->getSecond ( ) - std::next ( it )->getSecond ( );
+        facet.l2    = std::next ( it )->getFirst ( ) - it->getFirst ( );
+        facet.rhs   = facet.l1 * it->getFirst ( ) + facet.l2 * it->getSecond ( );
+        LPFacets.push_back ( facet );
+    }
+}
+
+/********************************************************************************************/
+bool tpm::ShrinkBox ( BOUNDS &box ) const
+{
+    for ( auto it = LPFacets.begin ( ); it != LPFacets.end ( ); ++it )
+    {
+        // As f2 <= f2.UB in the box, f1 >= ( rhs - l2*f2.UB ) / l1 and similarly for f2. Objective values are integral, so we may round up
+        if ( it->l1 > myZero )
+        {
+            double LB = std::ceil ( ( it->rhs - it->l2 * box.f2.UB ) / it->l1 - myTol );
+            if ( LB > box.f1.LB ) box.f1.LB = LB;
+        }
+        if ( it->l2 > myZero )
+        {
+            double LB = std::ceil ( ( it->rhs - it->l1 * box.f1.UB ) / it->l2 - myTol );
+            if ( LB > box.f2.LB ) box.f2.LB = LB;
+        }
+    }
+    return ( box.f1.LB <= box.f1.UB ) && ( box.f2.LB <= box.f2.UB );
+}
+
+/********************************************************************************************/
+tpm::BOUNDS tpm::TriangleBox ( const solution &left, const solution &right )
+{
+    BOUNDS box;
+    box.f1.LB = left.getFirst ( );
+    box.f1.UB = right.getFirst ( );
+    box.f2.LB = right.getSecond ( );
+    box.f2.UB = left.getSecond ( );
+    return box;
+}
+
+/********************************************************************************************/
+double tpm::UncoveredBelow ( double value ) const
+{
+    // Outcomes y with threshold <= y < value are dominated by value up to the approximation factor
+    double threshold = value;
+    if ( !RelativeEpsilon ) threshold = value - Epsilon;
+    else if ( value >= 0.0 ) threshold = value / ( 1.0 + Epsilon );
+    else if ( Epsilon < 1.0 ) threshold = value / ( 1.0 - Epsilon );
+    else return -IloInfinity; // Every y below a negative value is covered when the relative factor is one or more
+    return std::min ( std::ceil ( threshold ) - 1.0 , value - 1.0 );
+}
+
+/********************************************************************************************/
+void tpm::setApproximation ( double epsilon, bool relative )
+{
+    if ( epsilon < 0.0 )
+    {
+        std::cerr << "The approximation factor must be non negative. The exact frontier is computed.\n";
+        epsilon = 0.0;
+    }
+    Epsilon         = epsilon;
+    RelativeEpsilon = relative;
+}
+
+/********************************************************************************************/
+bool tpm::Solve ( CplexModel &theModel, double boxArea, SubproblemClass sub )
+{
+    // An explicit number of threads takes precedence over the global budget
+    bool UseBudget  = ( Threads == 0 ) && ThreadBudget::global ( ).isEnabled ( );
+    int threads     = UseBudget ? ThreadBudget::global ( ).acquire ( boxArea ) : Threads;
+    bool solved     = false;
+    CPUclock::time_point SolveStart;
+    try
+    {
+        if ( UseBudget ) theModel.setParameter ( IloCplex::Param::Threads , threads );
+        ApplyProfile ( theModel , Profiles[sub] );
+        SolveStart = CPUclock::now ( );
+        solved = theModel.cplex.solve ( );
+    }
+    catch ( ... )
+    {   // Hand back the threads before passing on the exception
+        if ( UseBudget ) ThreadBudget::global ( ).release ( threads );
+        throw;
+    }
+    if ( UseBudget ) ThreadBudget::global ( ).release ( threads );
+
+    // Collect statistics. ThreadsPerSolve holds the sum until RUN turns it into an average
+    std::lock_guard< std::mutex > lock ( SharedStateMutex ); // Slabs solve at the same time
+    ++theStatistics->NumberOfSolves;
+    theStatistics->ThreadsPerSolve += threads;
+    ++theStatistics->SubproblemSolves[sub];
+    theStatistics->SubproblemTime[sub] += duration_cast< duration < double > > ( CPUclock::now ( ) - SolveStart ).count ( );
+    return solved;
+}
+
+/********************************************************************************************/
+void tpm::ApplyProfile ( CplexModel &theModel, const ParameterProfile &profile )
+{
+    theModel.setParameter ( IloCplex::PreInd , profile.PreInd );
+    theModel.setParameter ( IloCplex::Reduce , profile.Reduce );
+    theModel.setParameter ( IloCplex::MIPEmphasis , profile.MIPEmphasis );
+    theModel.setParameter ( IloCplex::Probe , profile.Probe );
+    theModel.setParameter ( IloCplex::HeurFreq , profile.HeurFreq );
+    theModel.setParameter ( IloCplex::NodeSel , profile.NodeSel );
+}
+
+/********************************************************************************************/
+const char* tpm::SubproblemClassName ( SubproblemClass sub )
+{
+    static const char *Names[] = { "lexicographic" , "weighted" , "box" , "ranking" , "lp" };
+    return ( sub >= 0 && sub < NUMBER_OF_SUBPROBLEM_CLASSES ) ? Names[sub] : "unknown";
+}
+
+/********************************************************************************************/
+bool tpm::loadProfiles ( const std::string &FileName )
+{
+    std::ifstream InputFile ( FileName );
+    if ( !InputFile.is_open ( ) )
+    {
+        std::cerr << "Could not open the profile file " << FileName << std::endl;
+        return false;
+    }
+    std::string line;
+    int LineNumber = 0;
+    while ( std::getline ( InputFile , line ) )
+    {
+        ++LineNumber;
+        std::istringstream fields ( line );
+        std::string name, pair;
+        if ( !( fields >> name ) || name[0] == '#' ) continue; // Empty line or comment
+        int sub = 0;
+        while ( sub < NUMBER_OF_SUBPROBLEM_CLASSES && name != SubproblemClassName ( SubproblemClass ( sub ) ) ) ++sub;
+        if ( sub == NUMBER_OF_SUBPROBLEM_CLASSES )
+        {
+            std::cerr << "Unknown subproblem class " << name << " in line " << LineNumber << " of " << FileName << std::endl;
+            return false;
+        }
+        ParameterProfile profile = Profiles[sub];
+        while ( fields >> pair )
+        {
+            size_t eq = pair.find ( '=' );
+            std::string key = pair.substr ( 0 , eq );
+            IloInt value;
+            try
+            {
+                if ( eq == std::string::npos ) throw std::invalid_argument ( "no value" );
+                value = std::stol ( pair.substr ( eq + 1 ) );
+            }
+            catch ( std::exception &e )
+            {
+                std::cerr << "Could not read " << pair << " in line " << LineNumber << " of " << FileName << std::endl;
+                return false;
+            }
+            if ( key == "presolve" ) profile.PreInd = value;
+            else if ( key == "reduce" ) profile.Reduce = value;
+            else if ( key == "emphasis" ) profile.MIPEmphasis = value;
+            else if ( key == "probe" ) profile.Probe = value;
+            else if ( key == "heurfreq" ) profile.HeurFreq = value;
+            else if ( key == "nodesel" ) profile.NodeSel = value;
+            else
+            {
+                std::cerr << "Unknown parameter " << key << " in line " << LineNumber << " of " << FileName << std::endl;
+                return false;
+            }
+        }
+        Profiles[sub] = profile;
+    }
+    return true;
+}
+
+/********************************************************************************************/
+bool tpm::saveProfiles ( const std::string &FileName ) const
+{
+    std::ofstream OutputFile ( FileName );
+    if ( !OutputFile.is_open ( ) )
+    {
+        std::cerr << "Could not open the profile file " << FileName << std::endl;
+        return false;
+    }
+    OutputFile << "# Parameter profiles of the two phase method. Read by tpm::loadProfiles\n";
+    for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub )
+    {
+        const ParameterProfile &profile = Profiles[sub];
+        OutputFile  << SubproblemClassName ( SubproblemClass ( sub ) )
+                    << " presolve=" << profile.PreInd
+                    << " reduce=" << profile.Reduce
+                    << " emphasis=" << profile.MIPEmphasis
+                    << " probe=" << profile.Probe
+                    << " heurfreq=" << profile.HeurFreq
+                    << " nodesel=" << profile.NodeSel << "\n";
+    }
+    return bool ( OutputFile );
+}
+
+/********************************************************************************************/
+void tpm::SaveModelState ( CplexModel &theModel, MODELSTATE &state )
+{
+    state.f1.LB     = theModel.f1.getLB ( );
+    state.f1.UB     = theModel.f1.getUB ( );
+    state.f2.LB     = theModel.f2.getLB ( );
+    state.f2.UB     = theModel.f2.getUB ( );
+    state.TimeLimit = theModel.cplex.getParam ( IloCplex::Param::TimeLimit );
+    theModel.getWeights ( state.W1 , state.W2 );
+    state.Out       = &theModel.cplex.out ( );
+    state.Warning   = &theModel.cplex.warning ( );
+    state.Profile.PreInd        = theModel.cplex.getParam ( IloCplex::PreInd );
+    state.Profile.Reduce        = theModel.cplex.getParam ( IloCplex::Reduce );
+    state.Profile.MIPEmphasis   = theModel.cplex.getParam ( IloCplex::MIPEmphasis );
+    state.Profile.Probe         = theModel.cplex.getParam ( IloCplex::Probe );
+    state.Profile.HeurFreq      = theModel.cplex.getParam ( IloCplex::HeurFreq );
+    state.Profile.NodeSel       = theModel.cplex.getParam ( IloCplex::NodeSel );
+    state.ClockType = theModel.cplex.getParam ( IloCplex::ClockType );
+    state.Threads   = theModel.cplex.getParam ( IloCplex::Param::Threads );
+    state.MIPStarts = theModel.cplex.getNMIPStarts ( );
+}
+
+/********************************************************************************************/
+void tpm::RestoreModelState ( CplexModel &theModel, const MODELSTATE &state )
+{
+    try
+    {
+        theModel.setObjectiveBounds ( state.f1.LB , state.f1.UB , state.f2.LB , state.f2.UB );
+        theModel.setWeights ( state.W1 , state.W2 );
+        theModel.cplex.setOut ( *state.Out );
+        theModel.cplex.setWarning ( *state.Warning );
+        theModel.setParameter ( IloCplex::Param::TimeLimit , state.TimeLimit );
+        ApplyProfile ( theModel , state.Profile );
+        theModel.setParameter ( IloCplex::ClockType , state.ClockType );
+        theModel.setParameter ( IloCplex::Param::Threads , state.Threads );
+        // Remove the MIP starts added since the state was saved
+        int added = theModel.cplex.getNMIPStarts ( ) - state.MIPStarts;
+        if ( added > 0 ) theModel.cplex.deleteMIPStarts ( state.MIPStarts , added );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RestoreModelState in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
 /********************************************************************************************/
 void tpm::RunPhaseOne( CplexModel &theModel){
     try
@@ -166,18 +712,17 @@ void tpm::RunPhaseOne( CplexModel &theModel){
         auto MinusIt= NonDomSet.SupNDs.begin ( ); // Iterator used to point to solLR
 
         // Set cplex parameters
-        theModel.cplex.setParam ( IloCplex::EpAGap , 0.0 ); // Absolute gap is zero as we can assume nothing about the integrality of coeficients
-        theModel.cplex.setParam ( IloCplex::EpGap  , 0.0 ); // Relative gap is zero as we can assume nothing about the magnitude of the solutions
+        theModel.setParameter ( IloCplex::EpAGap , 0.0 ); // Absolute gap is zero as we can assume nothing about the integrality of coeficients
+        theModel.setParameter ( IloCplex::EpGap , 0.0 ); // Relative gap is zero as we can assume nothing about the magnitude of the solutions
         theModel.cplex.setOut( theModel.env.getNullStream ( ) );    // Tell cplex not to print the log
         theModel.cplex.setWarning( theModel.env.getNullStream ( ) );// Tell cplex not to print warnings
 
         /*==========================================================*/
         /*      Start by finding the upper left point               */
         /*==========================================================*/
-        theModel.OBJ.setLinearCoef( theModel.f1 , 1.0 ); // Full weight on objective one
-        theModel.OBJ.setLinearCoef( theModel.f2 , 0.0 ); // No weight on objective two
+        theModel.setWeights ( 1.0 , 0.0 ); // Full weight on objective one, no weight on objective two
 
-        if( theModel.cplex.solve ( ) ) // Solve the problem. If we cant, we need to terminate, and an error is thrown
+        if( Solve ( theModel , IloInfinity , SUBPROBLEM_LEXICOGRAPHIC ) ) // Solve the problem. If we cant, we need to terminate, and an error is thrown
         {
             theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( ); // Collect the number of branching nodes
 
@@ -189,26 +734,27 @@ void tpm::RunPhaseOne( CplexModel &theModel){
             TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
             if ( TimeUntilNow.count ( ) > 3600.0 ) //
             {
-                std::cout << "=========== Timeout ===========\n";
+                TimedOut = true;
+                TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
                 goto END;
             }
             // We now have the objective function value of the first objective
             p.first = theModel.cplex.getValue( theModel.f1 );
             // Now change objective function coefficients and bounds on f1
-            theModel.f1.setUB( p.first + myTol ); // Add a little to ensure nothing goes wrong
-            theModel.OBJ.setLinearCoef( theModel.f1 , 0 );
-            theModel.OBJ.setLinearCoef( theModel.f2 , 1 );
+            theModel.setF1UB ( p.first + myTol ); // Add a little to ensure nothing goes wrong
+            theModel.setWeights ( 0 , 1 );
 
             // Resolve to get the lexicographic minimizer
-            theModel.cplex.setParam(IloCplex::Param::TimeLimit , 36000 );
-            if ( theModel.cplex.solve ( ) )
+            theModel.setParameter ( IloCplex::Param::TimeLimit , 36000 );
+            if ( Solve ( theModel , IloInfinity , SUBPROBLEM_LEXICOGRAPHIC ) )
             {
                 theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
                 endTime = CPUclock::now ( );
                 TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
                 if ( TimeUntilNow.count ( ) > 3600.0 )
                 {
-                    std::cout << "=========== Timeout ===========\n";
+                    TimedOut = true;
+                    TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
                     goto END;
                 }
                 p.second = theModel.cplex.getValue( theModel.f2 );
@@ -224,7 +770,7 @@ void tpm::RunPhaseOne( CplexModel &theModel){
                 VarVals.clear ( );
                 solUL = sol;
                 // Remember to set the upper bound of f1 back to IloInfinity
-                theModel.f1.setUB ( IloInfinity );
+                theModel.setF1UB ( IloInfinity );
             }else
             {
                 throw std::runtime_error ( "Could not solve the model second time in order to find z^ul" );
@@ -237,10 +783,9 @@ void tpm::RunPhaseOne( CplexModel &theModel){
         /*==========================================================*/
         /*      Continue by finding the lower right point           */
         /*==========================================================*/
-        theModel.OBJ.setLinearCoef( theModel.f1 , 0 );  // No weight on first objective
-        theModel.OBJ.setLinearCoef( theModel.f2 , 1 );  // Full weight on second objective
+        theModel.setWeights ( 0 , 1 );  // No weight on first objective, full weight on second objective
 
-        if ( theModel.cplex.solve ( ) ) // Solve the problem. If we cant, we need to terminate, and an error is thrown
+        if ( Solve ( theModel , IloInfinity , SUBPROBLEM_LEXICOGRAPHIC ) ) // Solve the problem. If we cant, we need to terminate, and an error is thrown
         {
             theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( ); // Collect branching nodes
 
@@ -252,18 +797,18 @@ void tpm::RunPhaseOne( CplexModel &theModel){
             TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
             if ( TimeUntilNow.count ( ) > 3600.0 )
             {
-                std::cout << "=========== Timeout ===========\n";
+                TimedOut = true;
+                TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
                 goto END;
             }
             // We now have the objective function value of the second objective
             p.second = theModel.cplex.getValue( theModel.f2 );
             // Now change objective function coefficients and bounds on f2
-            theModel.f2.setUB( p.second+0.1 ); // Add a little to ensure nothing goes wrong
-            theModel.OBJ.setLinearCoef( theModel.f1 , 1 );
-            theModel.OBJ.setLinearCoef( theModel.f2 , 0 );
+            theModel.setF2UB ( p.second+0.1 ); // Add a little to ensure nothing goes wrong
+            theModel.setWeights ( 1 , 0 );
 
             // Resolve to get the lexicographic minimizer
-            if ( theModel.cplex.solve ( ) )
+            if ( Solve ( theModel , IloInfinity , SUBPROBLEM_LEXICOGRAPHIC ) )
             {
                 theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( ); // Collext branching nodes
                 /*=============================================================*/
@@ -274,7 +819,8 @@ void tpm::RunPhaseOne( CplexModel &theModel){
                 TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
                 if ( TimeUntilNow.count ( ) > 3600.0 )
                 {
-                    std::cout << "=========== Timeout ===========\n";
+                    TimedOut = true;
+                    TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
                     goto END;
                 }
                 for ( int s = 0; s < theModel.AllVars.getSize (); ++s )
@@ -291,7 +837,7 @@ void tpm::RunPhaseOne( CplexModel &theModel){
                 else OnlyOneNonDomSol = true;
                 solLR = sol;
                 // Remember to set the ubber buund of f2 back to iloinfinity
-                theModel.f2.setUB ( IloInfinity );
+                theModel.setF2UB ( IloInfinity );
             }else
             {
                 throw std::runtime_error ( "Could not solve the model in order to find z^ul" );
@@ -316,11 +862,10 @@ void tpm::RunPhaseOne( CplexModel &theModel){
                 lambda2 = ( MinusIt->getFirst ( ) - PlusIt->getFirst ( ) );     // Calculate the weight of the second objective
 
                 // Update the objective coefficients
-                theModel.OBJ.setLinearCoef( theModel.f1 , lambda1 );
-                theModel.OBJ.setLinearCoef( theModel.f2 , lambda2 );
+                theModel.setWeights ( lambda1 , lambda2 );
 
                 // If we could not solve, throw a runtime error
-                if ( !( theModel.cplex.solve ( ) ) ) throw std::runtime_error ( "Could not solve the subproblem in phase on of the two phase method " );
+                if ( !( Solve ( theModel , IloInfinity , SUBPROBLEM_WEIGHTED ) ) ) throw std::runtime_error ( "Could not solve the subproblem in phase on of the two phase method " );
                 theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( ); // Collect branching nodes
 
                 /*=============================================================*/
@@ -331,7 +876,8 @@ void tpm::RunPhaseOne( CplexModel &theModel){
                 TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
                 if ( TimeUntilNow.count ( ) > 3600.0 )
                 {
-                    std::cout << "=========== Timeout ===========\n";
+                    TimedOut = true;
+                    TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
                     goto END;
                 }
 
@@ -357,6 +903,11 @@ void tpm::RunPhaseOne( CplexModel &theModel){
         END:
         // Copy the solutions found in phase one into the set of non-dominated solutions
         NonDomSet.copySupToNonDom ( );
+        // The hypervolume is measured with respect to the nadir point of the extreme supported outcomes plus one
+        if ( !NonDomSet.SupNDs.empty ( ) )
+        {
+            NonDomSet.setReferencePoint ( NonDomSet.SupNDs.back ( ).getFirst ( ) + 1.0 , NonDomSet.SupNDs.front ( ).getSecond ( ) + 1.0 );
+        }
 
         theStatistics->NumberOfPhaseOneSolutions = NonDomSet.NDs.size ( );
     }catch(std::exception &e){
@@ -369,284 +920,1319 @@ void tpm::RunPhaseOne( CplexModel &theModel){
 }
 
 /********************************************************************************************/
-void tpm::RunPhaseTwo ( CplexModel &theModel )
+bool tpm::RunPhaseOneLP ( CplexModel &theModel )
 {
     try
     {
-        CPUclock::time_point endTime;
-        std::chrono::duration<double> TimeUntilNow;
-        IloBoolVarArray branchVar(theModel.env);
-        bool OnlyOneNonDomSol = (NonDomSet.NDs.size ( ) == 1); // Check if only one solution was found in phase one
-        int triangle        = 0,   // Variable used to count the triangles
-            NumOfTriangles  = NonDomSet.NDs.size ( ) - 1,  // Variable holding the number of triangles we should process
-            NumOfVars       = theModel.AllVars.getSize ( );
-        double  lambda1=0.0, // Weight of first objective
-                lambda2=0.0; // Weight of second objective
-        std::pair<double,double> p; // Pair used to store outcome vector of a solution
-        BOUNDS CurrentBounds;   // BOUNDS variable to hold the current bounds on the objective functions
-        std::list<BOUNDS> bounds;   // List of BOUNDS
-        std::list<solution>::iterator nextSol; // Iterator to the "next" solution on the list of non--dominated solutions
-        std::vector<double> VarValues;
-        // Tell cplex not to print to the console
+        std::list< solution > Extremes;     // Extreme points of the LP relaxation lower bound set
+        std::vector<double> VarVals;        // Vector used to hold the current solution
+
+        // Set cplex parameters as in RunPhaseOne, as phase two relies on them
+        theModel.setParameter ( IloCplex::EpAGap , 0.0 );
+        theModel.setParameter ( IloCplex::EpGap , 0.0 );
         theModel.cplex.setOut( theModel.env.getNullStream ( ) );
+        theModel.cplex.setWarning( theModel.env.getNullStream ( ) );
+
+        // Consecutive LPs differ in the objective only, so the primal simplex method starts from an optimal basis of the previous one
+        IloInt RootAlgorithm = theModel.cplex.getParam ( IloCplex::RootAlg );
+        theModel.setParameter ( IloCplex::RootAlg , IloCplex::Primal );
+        bool solved = ComputeLPBoundSet ( theModel , Extremes , true );
+        theModel.setParameter ( IloCplex::RootAlg , RootAlgorithm );
+        if ( !solved )
+        {
+            TPM_LOG ( LOG_WARNING , "phase_one_lp failed=1 fallback=mip" );
+            return false;
+        }
 
-        // loop over all supported non-dominated points
-        for ( auto it = NonDomSet.SupNDs.begin ( ); !OnlyOneNonDomSol && std::next ( it )!=NonDomSet.SupNDs.end ( ); ++it )
+        std::list< solution > Supported;
+        for ( auto it = Extremes.begin ( ); it != Extremes.end ( ); ++it )
         {
-            if ( PrintProgress )
+            // The extreme points should be integral. Remove the noise left by the simplex method, and give up on the first one that is not
+            bool integral = ( std::fabs ( it->getFirst ( ) - std::round ( it->getFirst ( ) ) ) < myZero && std::fabs ( it->getSecond ( ) - std::round ( it->getSecond ( ) ) ) < myZero );
+            it->getVarValues ( VarVals );
+            for ( size_t i = 0; i < VarVals.size ( ); ++i )
             {
-                std::cout << "Processing triangle " << ++triangle << " of " << NumOfTriangles << "\n";
+                if ( std::fabs ( VarVals[i] - std::round ( VarVals[i] ) ) < myZero ) VarVals[i] = std::round ( VarVals[i] );
+                else if ( theModel.AllVars[i].getType ( ) != ILOFLOAT ) integral = false;
             }
-            // Retreive the solution following it
-            nextSol = std::next ( it );
-
-            // Set the bounds on the objectives based on the current triangle
-            theModel.f2.setUB ( it->getSecond ( ) );
-            theModel.f1.setUB ( nextSol->getFirst ( ) );
-
-            // Calculate the slope of the search direction
-            lambda1 = it->getSecond ( ) - nextSol->getSecond ( );
-            lambda2 = nextSol->getFirst ( ) - it->getFirst ( );
-
-            // Set the objective function coefficients according to it and nextSol
-            theModel.OBJ.setLinearCoef( theModel.f1 , lambda1 );
-            theModel.OBJ.setLinearCoef( theModel.f2 , lambda2 );
-
-            // Initialize the stack of subproblems
-            BOUNDS FirstBounds;
-            FirstBounds.f1.UB = nextSol->getFirst ( ) ;
-            FirstBounds.f1.LB = it->getFirst ( ) ;
-            FirstBounds.f2.UB = it->getSecond ( ) ;
-            FirstBounds.f2.LB = nextSol->getSecond ( ) ;
-            bounds.push_back ( FirstBounds );
-
-            while ( !bounds.empty ( ) )
+            if ( !integral )
             {
-                if ( TakeFront )
-                {   // Get the first element on the
-                    CurrentBounds = bounds.front ( ); // Get the back of the vector
-                    bounds.erase ( bounds.begin( ) ); // Pop the back, so we do not need to inspect it again
-                }
-                else
-                {   // Get the last element on the
-                    CurrentBounds = bounds.back ( );
-                    bounds.pop_back ( );
-                }
-
-
-                theModel.f1.setBounds ( CurrentBounds.f1.LB , CurrentBounds.f1.UB );
-                theModel.f2.setBounds ( CurrentBounds.f2.LB , CurrentBounds.f2.UB );
-
-                theModel.cplex.setParam(IloCplex::Param::TimeLimit , 3600 );
-                endTime = CPUclock::now ( );
-                TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
-                if ( TimeUntilNow.count ( ) > 3600.0 )
-                {
-                    std::cout << "=========== Timeout ===========\n";
-                    goto END;
-                }
-                if ( theModel.cplex.solve ( ) )
-                {
-                    // Update the Time left
-                    theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes();
-
-                    // If the current model has a solution, get it!
-                    p.first = theModel.cplex.getValue( theModel.f1 );
-                    p.second = theModel.cplex.getValue( theModel.f2 );
-                    // Create a new solution, and insert it into the non-dominated set
-                    for ( int  i = 0; i < NumOfVars; ++i )
-                    {
-                        VarValues.push_back( theModel.cplex.getValue ( theModel.AllVars[i] ) );
-                    }
-                    solution sol = solution ( false , p , VarValues );
-                    NonDomSet.updateNDS( sol );
-                    VarValues.clear ( );
-                    // Create two new subproblems:
-                    {  // First subproblem, to the left of the current outcome vector
-                        if ( p.first -1 < CurrentBounds.f1.LB || p.second +1 > CurrentBounds.f2.UB )
-                        {}// The left subproblem is infeasible, and should not be added!
-                        else
-                        { // The left subproblem might be feasible, we create it, and se what happens
-                           BOUNDS leftBounds;
-                           leftBounds.f1.LB = CurrentBounds.f1.LB;
-                           leftBounds.f1.UB = p.first - 1.0;
-                           leftBounds.f2.LB = p.second + 1.0;
-                           leftBounds.f2.UB = CurrentBounds.f2.UB;
-                           bounds.push_back( leftBounds );
-                        }
-
-                        // Now create the subproblem to the right
-                        if ( ( p.second -1.0 < CurrentBounds.f2.LB ) || ( p.first + 1.0 >= CurrentBounds.f1.UB ) )
-                        {} // The right subproblem is infeasible, and we can descard it
-                        else
-                        { // The right subproblem might be feasible, we create it, and se what happens.
-                            BOUNDS rightBounds;
-                            rightBounds.f1.LB = p.first + 1.0;
-                            rightBounds.f1.UB = CurrentBounds.f1.UB;
-                            rightBounds.f2.LB = CurrentBounds.f2.LB;
-                            rightBounds.f2.UB = p.second - 1.0;
-                            bounds.push_back( rightBounds );
-                        }
-                    }
-                }
+                TPM_LOG ( LOG_WARNING , "phase_one_lp integral=0 fallback=mip" );
+                return false;
             }
+            Supported.push_back ( solution ( true , std::make_pair ( std::round ( it->getFirst ( ) ) , std::round ( it->getSecond ( ) ) ) , VarVals ) );
         }
-        END:
-        std::cout << "Number of supported efficient solutions     : " << NonDomSet.SupNDs.size ( ) << std::endl;
-        std::cout << "Number of non supported efficient solutions : " << (NonDomSet.NDs.size ( ) - NonDomSet.SupNDs.size ( ) ) << std::endl;
-
-        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
-        theStatistics->NumberOfPhaseTwoSolutions = theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions;
-
+        NonDomSet.SupNDs.splice ( NonDomSet.SupNDs.end ( ) , Supported );
 
+        // Copy the solutions found in phase one into the set of non-dominated solutions
+        NonDomSet.copySupToNonDom ( );
+        if ( !NonDomSet.SupNDs.empty ( ) )
+        {
+            NonDomSet.setReferencePoint ( NonDomSet.SupNDs.back ( ).getFirst ( ) + 1.0 , NonDomSet.SupNDs.front ( ).getSecond ( ) + 1.0 );
+        }
+        theStatistics->NumberOfPhaseOneSolutions = NonDomSet.NDs.size ( );
+        TPM_LOG ( LOG_INFO , "phase_one_lp extreme_points=" << NonDomSet.SupNDs.size ( ) << " lps=" << theStatistics->NumberOfSolves );
+        return true;
     }
     catch ( std::exception &e )
     {
-        std::cerr << "Exception in RunTwoPhase in the tpm class : " << e.what ( ) << std::endl;
+        std::cerr << "Exception in RunPhaseOneLP in the tpm class : " << e.what ( ) << std::endl;
         exit ( EXIT_FAILURE );
     }
     catch ( IloException &ie )
     {
-        std::cerr << "IloException in RunTwoPhase in the tpm class : " << ie.getMessage ( )  << std::endl;
+        std::cerr << "IloException in RunPhaseOneLP in the tpm class : " << ie.getMessage ( ) << std::endl;
         exit ( EXIT_FAILURE );
     }
 }
 
 /********************************************************************************************/
-void tpm::RunPhaseTwoRanking( CplexModel &theModel )
+bool tpm::IsTotallyUnimodular ( CplexModel &theModel ) const
 {
     try
     {
-        IloInt NumOfVars = theModel.AllVars.getSize ( ); // Variable used to store the number of variables in the current model
-        IloBoolVarArray branchVar(theModel.env);
-        bool OnlyOneNonDomSol = (NonDomSet.NDs.size ( ) == 1);
-        int     triangle = 0,
-                NumOfTriangles = NonDomSet.NDs.size ( ) - 1;
-        double  f1_bound=0.0,// Upper bound on objective 1
-                f2_bound=0.0,// Upper bound on objective 2
-                lambda1=0.0, // Weight of first objective
-                lambda2=0.0, // Weight of second objective
-                LNP    =0.0, // Local Nadir point value wrt the current weight vector
-                WLNP   =0.0, // Worst local Nadir point wrt the current weight vector
-                ObjV   =0.0; // Objective function value of cplex.
-        unsigned long iterations = 0;
-        IloExpr NoGood = IloExpr( theModel.env ); // IloExpression used to build the no good inequalities
-        std::pair<double,double> p; // Pair used to store outcome vector of a solution
-        std::vector<double> Sol(NumOfVars), oldSol(NumOfVars);
-
+        struct NONZERO{
+            IloInt Row;
+            double Coef;
+        }; // A nonzero of a column
+        IloInt n = theModel.AllVars.getSize ( ),
+               m = theModel.Rows.getSize ( );
+        // Only the rows in Rows are inspected. A constraint added to the model directly could break total unimodularity
+        if ( !theModel.rowsCoverModel ( ) )
+        {
+            TPM_LOG ( LOG_INFO , "totally_unimodular test=skipped reason=rows_not_covered" );
+            return false;
+        }
+        auto Integral = [&] ( double value ) { return std::fabs ( value ) >= IloInfinity || std::fabs ( value - std::round ( value ) ) < myZero; };
 
+        // Map the variables to their columns. All must be integer with integral bounds
+        std::unordered_map< IloInt , IloInt > Column;
+        for ( IloInt j = 0; j < n; ++j )
+        {
+            const IloNumVar &var = theModel.AllVars[j];
+            if ( var.getType ( ) == ILOFLOAT || !Integral ( var.getLB ( ) ) || !Integral ( var.getUB ( ) ) ) return false;
+            Column[var.getId ( )] = j;
+        }
 
-        if ( !OnlyOneNonDomSol )
+        // Collect the nonzeros of each column. The rows defining f1 and f2 are not part of the constraint matrix
+        std::vector< std::vector< NONZERO > > Nonzeros ( n );
+        for ( IloInt r = 0; r < m; ++r )
         {
-            auto startTime = CPUclock::now ( );
-            for ( auto SupIt = NonDomSet.SupNDs.begin (); std::next( SupIt ) != NonDomSet.SupNDs.end ( ); ++SupIt )
+            const IloRange &row = theModel.Rows[r];
+            if ( !Integral ( row.getLB ( ) ) || !Integral ( row.getUB ( ) ) ) return false;
+            bool ObjectiveRow = false;
+            std::vector< std::pair< IloInt , double > > entries;
+            IloExpr expr = row.getExpr ( );
+            for ( IloExpr::LinearIterator it = expr.getLinearIterator ( ); it.ok ( ); ++it )
             {
-                std::cout << "Triangle " << ++triangle << " of " << NumOfTriangles << std::endl;
-                // Retrieve the bound of the current triangle
-                f1_bound = std::next( SupIt )->getFirst ( ) - 1.0;
-                f2_bound = SupIt->getSecond ( ) - 1.0;
-                // Set the bound in the cplex model
-                theModel.f1.setBounds( SupIt->getFirst ( ) , f1_bound  );
-                theModel.f2.setBounds( std::next ( SupIt )->getSecond ( ) , f2_bound );
-
-                // Calculate the slope of the search direction
-                lambda1 = SupIt->getSecond ( ) - std::next ( SupIt )->getSecond ( );
-                lambda2 = std::next ( SupIt )->getFirst ( ) - SupIt->getFirst ( );
-                // Set the objective function coefficients according to it and nextSol
-                theModel.OBJ.setLinearCoef( theModel.f1 , lambda1 );
-                theModel.OBJ.setLinearCoef( theModel.f2 , lambda2 );
-
-                // Set time limit
-                theModel.cplex.setParam(IloCplex::ClockType , 2);
-                theModel.cplex.setParam( IloCplex::Param::TimeLimit , totalTime);
-
-                // As long as cplex solves the problem, we continue to rank
-                while ( theModel.cplex.solve ( ) )
+                IloInt id = it.getVar ( ).getId ( );
+                if ( id == theModel.f1.getId ( ) || id == theModel.f2.getId ( ) )
                 {
-                    ++iterations; // Iterations counter is incremented
-
-                    /*=====================================================*/
-                    /*      Calculate the total time consumption and       */
-                    /*      to the time limit                              */
-                    /*=====================================================*/
-                    auto nowTime = CPUclock::now ( );
-                    double time = duration_cast<std::chrono::duration<double>>( nowTime - startTime ).count ( );
-                    if ( totalTime < time ) break;
-
-                    theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
-                    // Retrieve the info of the current solution!
-                    p.first = theModel.cplex.getValue( theModel.f1 );
-                    p.second = theModel.cplex.getValue( theModel.f2 );
-                    ObjV = theModel.cplex.getObjValue ( );
-
-                    // Calculate the worst local NAdir point in the current triangle
-                    WLNP = 0.0;
-                    for ( auto it = NonDomSet.NDs.begin (); std::next(it)!= NonDomSet.NDs.end ( ); ++it )
-                    {
-                        if ( std::next(it)->getFirst ( ) > f1_bound ) break;
-                        else if ( it->getFirst ( ) >= SupIt->getFirst ( ) )
-                        {
-                            LNP = lambda1 * std::next(it)->getFirst ( ) + lambda2 * (it->getSecond ( ) );
-                            if ( LNP > WLNP ) WLNP = LNP;
-                        }
-                    }
-
-                    // Retreive the current solution, and build the no good inequality
-                    for ( int var = 0; var<NumOfVars; ++ var )
-                    {
-                        oldSol[var] = Sol[var];
-                        if ( theModel.cplex.getValue ( theModel.AllVars[var] ) >= 0.5 )
-                        {
-                            Sol[var] = 1;
-                            NoGood += (1 - theModel.AllVars[var] );
-                        }
-                        else
-                        {
-                            Sol[var] = 0;
-                            NoGood += theModel.AllVars[var];
-                        }
-                    }
-                    // Create a new solution, and update the non-dominated set
-                    solution sol = solution ( false , p , Sol);
-                    NonDomSet.updateNDS( sol );
-
-                    // Calculate the hamming distance between the current and the previous solutions
-                    int Diff = 0;
-                    for ( int i=0; i<NumOfVars; ++i )
-                    {
-                        Diff += std::max ( Sol[i] - oldSol[i] , oldSol[i] - Sol[i] );
-                    }
-
-                    // Add the no-good inequality and  clear the iloexpr
-                    theModel.model.add ( NoGood >= 1 );
-                    NoGood.clear ( );
-
-                    // If PrintProgress is true, print the progress:
-                    if ( PrintProgress )
-                    {
-                        std::cout   << "it : " << iterations
-                                    << "\t UB : " << WLNP
-                                    << "\t LB : " << ObjV
-                                    << "\t Gap : " << ( WLNP - ObjV ) / ObjV
-                                    << "\t Diff : " << Diff
-                                    << "\t Time : " << totalTime << std::endl;
-                    }
-                    // If the value of the worst local Nadir point exceeds the current objective function value, we can stop the search in the current trianle
-                    if ( ObjV >= WLNP ) break;
+                    ObjectiveRow = true;
+                    break;
                 }
-
+                auto col = Column.find ( id );
+                if ( col == Column.end ( ) ) return false; // A variable which is not in AllVars
+                if ( std::fabs ( it.getCoef ( ) ) < myZero ) continue;
+                if ( std::fabs ( std::fabs ( it.getCoef ( ) ) - 1.0 ) > myZero ) return false;
+                entries.push_back ( std::make_pair ( col->second , it.getCoef ( ) ) );
+            }
+            if ( ObjectiveRow ) continue;
+            for ( auto it = entries.begin ( ); it != entries.end ( ); ++it )
+            {
+                Nonzeros[it->first].push_back ( { r , it->second } );
+                if ( Nonzeros[it->first].size ( ) > 2 ) return false;
             }
         }
-        theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
-        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
-        theStatistics->NumberOfPhaseTwoSolutions = theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions;
 
-        NoGood.end ( );
-    }
-    catch ( IloException &ie )
-    {
-        std::cerr << "IloException in RunPhaseTwoRanking in the tpm class : " << ie.getMessage ( ) << std::endl;
-    }
+        // Split the rows into two sets by a union find, where Parity of a row tells if it is in the same set as its parent
+        std::vector< IloInt > Parent ( m );
+        std::vector< int > Parity ( m , 0 ),
+                           Rank ( m , 0 );
+        for ( IloInt r = 0; r < m; ++r ) Parent[r] = r;
+        auto Find = [&] ( IloInt r, int &parity )
+        {
+            parity = 0;
+            while ( Parent[r] != r )
+            {
+                parity ^= Parity[r];
+                r = Parent[r];
+            }
+            return r;
+        };
+        for ( IloInt j = 0; j < n; ++j )
+        {
+            if ( Nonzeros[j].size ( ) < 2 ) continue;
+            // Nonzeros of the same sign must be in different sets, and nonzeros of opposite signs in the same set
+            int differ = ( Nonzeros[j][0].Coef * Nonzeros[j][1].Coef > 0.0 ) ? 1 : 0;
+            int p0, p1;
+            IloInt r0 = Find ( Nonzeros[j][0].Row , p0 ),
+                   r1 = Find ( Nonzeros[j][1].Row , p1 );
+            if ( r0 == r1 )
+            {
+                if ( ( p0 ^ p1 ) != differ ) return false;
+            }
+            else
+            {   // Union by rank keeps the trees shallow
+                if ( Rank[r0] < Rank[r1] ) std::swap ( r0 , r1 );
+                Parent[r1] = r0;
+                Parity[r1] = p0 ^ p1 ^ differ;
+                if ( Rank[r0] == Rank[r1] ) ++Rank[r0];
+            }
+        }
+        return true;
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in IsTotallyUnimodular in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::RunPhaseZero ( CplexModel &theModel )
+{
+    try
+    {
+        NDS Candidates; // Solutions found, of which only the non-dominated ones are kept
+        Candidates.setIntegerCoordinates ( IntegerOutcomes );
+
+        // Problem specific heuristic
+        if ( PhaseZeroHeuristic )
+        {
+            std::list< solution > found;
+            PhaseZeroHeuristic ( found );
+            Candidates.updateNDS ( std::vector< solution > ( found.begin ( ) , found.end ( ) ) );
+        }
+
+        // Short solves of weighted sums. Every solution in the solution pool is a candidate
+        if ( PhaseZeroWeights > 0 )
+        {
+            double TimeLimit = theModel.cplex.getParam ( IloCplex::Param::TimeLimit );
+            std::pair<double,double> p;
+            std::vector<double> VarVals;
+            std::vector< solution > Pool;   // The solution pool of one solve, filtered as a batch
+            IloNumArray vals ( theModel.env );
+            theModel.cplex.setOut( theModel.env.getNullStream ( ) );
+            theModel.cplex.setWarning( theModel.env.getNullStream ( ) );
+            theModel.setParameter ( IloCplex::Param::TimeLimit , PhaseZeroSeconds );
+            for ( int k = 0; k < PhaseZeroWeights; ++k )
+            {
+                // Weight vectors spread evenly from ( 1 , 0 ) to ( 0 , 1 )
+                double t = ( PhaseZeroWeights > 1 ) ? double ( k ) / ( PhaseZeroWeights - 1 ) : 0.5;
+                theModel.setWeights ( 1.0 - t , t );
+                if ( !Solve ( theModel , IloInfinity , SUBPROBLEM_WEIGHTED ) ) continue; // Nothing found within the time limit
+                theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
+                Pool.clear ( );
+                for ( int s = 0; s < theModel.cplex.getSolnPoolNsolns ( ); ++s )
+                {
+                    p.first     = theModel.cplex.getValue ( theModel.f1 , s );
+                    p.second    = theModel.cplex.getValue ( theModel.f2 , s );
+                    theModel.cplex.getValues ( vals , theModel.AllVars , s );
+                    VarVals.resize ( vals.getSize ( ) );
+                    for ( IloInt i = 0; i < vals.getSize ( ); ++i ) VarVals[i] = vals[i];
+                    Pool.push_back ( solution ( false , p , VarVals ) );
+                }
+                Candidates.updateNDS ( Pool );
+            }
+            theModel.setParameter ( IloCplex::Param::TimeLimit , TimeLimit );
+            vals.end ( );
+        }
+
+        // The candidates are checked against the model before they are used
+        SeedFrontier ( theModel , Candidates.NDs , false );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in RunPhaseZero in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RunPhaseZero in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::SeedFrontier ( CplexModel &theModel, const std::list< solution > &candidates, bool previousRun )
+{
+    try
+    {
+        IloInt n = theModel.AllVars.getSize ( ),
+               m = theModel.Rows.getSize ( );
+        IloNumArray vals ( theModel.env , n );
+        std::vector< double > x;    // Variable values of the current solution, followed by f1 and f2
+        // A solution put on the frontier before phase two keeps the boxes it dominates from being searched. Unless the rows are all of the model,
+        // passing them proves nothing, so the solutions are then only handed to cplex as MIP starts, which cplex checks itself
+        bool Covered = theModel.rowsCoverModel ( );
+        if ( !Covered ) TPM_LOG ( LOG_WARNING , "seed_frontier frontier=0 reason=rows_not_covered candidates=" << candidates.size ( ) );
+
+        // Map the variables to their columns. f1 and f2 get the columns n and n+1
+        std::unordered_map< IloInt , IloInt > Column;
+        for ( IloInt j = 0; j < n; ++j ) Column[theModel.AllVars[j].getId ( )] = j;
+        Column[theModel.f1.getId ( )] = n;
+        Column[theModel.f2.getId ( )] = n + 1;
+
+        // Read the rows once in compressed sparse row format
+        std::vector< double > lb ( m ), ub ( m ), val;
+        std::vector< IloInt > start ( 1 , 0 ), ind;
+        for ( IloInt r = 0; r < m; ++r )
+        {
+            lb[r] = theModel.Rows[r].getLB ( );
+            ub[r] = theModel.Rows[r].getUB ( );
+            IloExpr expr = theModel.Rows[r].getExpr ( );
+            for ( IloExpr::LinearIterator it = expr.getLinearIterator ( ); it.ok ( ); ++it )
+            {
+                auto col = Column.find ( it.getVar ( ).getId ( ) );
+                if ( col == Column.end ( ) ) throw std::runtime_error ( "A row holds a variable which is not in AllVars" );
+                ind.push_back ( col->second );
+                val.push_back ( it.getCoef ( ) );
+            }
+            start.push_back ( ind.size ( ) );
+        }
+
+        for ( auto sol = candidates.begin ( ); sol != candidates.end ( ); ++sol )
+        {
+            sol->getVarValues ( x );
+            if ( (IloInt) x.size ( ) != n ) continue; // From a different model
+            // Integer variables are rounded, and all variables are moved inside their bounds
+            for ( IloInt j = 0; j < n; ++j )
+            {
+                const IloNumVar &var = theModel.AllVars[j];
+                if ( var.getType ( ) != ILOFLOAT ) x[j] = std::round ( x[j] );
+                x[j] = std::min ( std::max ( x[j] , var.getLB ( ) ) , var.getUB ( ) );
+            }
+
+            // f1 and f2 are given by the equality rows defining them
+            x.resize ( n + 2 , std::numeric_limits< double >::quiet_NaN ( ) );
+            for ( IloInt r = 0; r < m; ++r )
+            {
+                IloInt objective = -1;
+                double coef = 0.0, rest = 0.0;
+                for ( IloInt k = start[r]; k < start[r+1]; ++k )
+                {
+                    if ( ind[k] >= n )
+                    {
+                        objective = ( objective < 0 ) ? ind[k] : n + 2; // A row with both f1 and f2 defines neither
+                        coef = val[k];
+                    }
+                    else rest += val[k] * x[ind[k]];
+                }
+                if ( objective >= n && objective < n + 2 && lb[r] == ub[r] && std::fabs ( coef ) > myZero ) x[objective] = ( lb[r] - rest ) / coef;
+            }
+
+            // Evaluate every row
+            bool feasible = !std::isnan ( x[n] ) && !std::isnan ( x[n + 1] );
+            for ( IloInt r = 0; feasible && r < m; ++r )
+            {
+                double activity = 0.0;
+                for ( IloInt k = start[r]; k < start[r+1]; ++k ) activity += val[k] * x[ind[k]];
+                feasible = ( activity >= lb[r] - myZero * ( 1.0 + std::fabs ( lb[r] ) ) ) && ( activity <= ub[r] + myZero * ( 1.0 + std::fabs ( ub[r] ) ) );
+            }
+
+            if ( feasible && Covered )
+            {
+                Seeds.push_back ( solution ( false , std::make_pair ( x[n] , x[n + 1] ) , std::vector< double > ( x.begin ( ) , x.begin ( ) + n ) ) );
+                ++( previousRun ? theStatistics->NumberOfReusedSolutions : theStatistics->NumberOfPhaseZeroSolutions );
+            }
+            else if ( previousRun && sol->isSupported ( ) ) ++theStatistics->NumberOfRepairStarts;
+            // The previous supported solutions are likely to stay optimal for some weights in phase one. Heuristic solutions are all good starts
+            if ( previousRun ? sol->isSupported ( ) : feasible )
+            {
+                for ( IloInt j = 0; j < n; ++j ) vals[j] = x[j];
+                theModel.cplex.addMIPStart ( theModel.AllVars , vals , feasible ? IloCplex::MIPStartAuto : IloCplex::MIPStartRepair );
+            }
+        }
+        vals.end ( );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in SeedFrontier in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in SeedFrontier in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::StaircaseBoxes ( const BOUNDS &outer, const solution &left, const solution &right, std::vector< BOUNDS > &boxes )
+{
+    boxes.clear ( );
+    // The corners of the triangle and the outcomes on the frontier between them, sorted by increasing first objective value
+    std::vector< std::pair< double , double > > steps ( 1 , std::make_pair ( left.getFirst ( ) , left.getSecond ( ) ) );
+    for ( auto it = NonDomSet.NDs.begin ( ); it != NonDomSet.NDs.end ( ); ++it )
+    {
+        if ( it->getFirst ( ) > left.getFirst ( ) + myTol && it->getFirst ( ) < right.getFirst ( ) - myTol ) steps.push_back ( std::make_pair ( it->getFirst ( ) , it->getSecond ( ) ) );
+    }
+    steps.push_back ( std::make_pair ( right.getFirst ( ) , right.getSecond ( ) ) );
+
+    for ( size_t i = 0; i + 1 < steps.size ( ); ++i )
+    {
+        BOUNDS box = outer;
+        box.f1.LB = std::max ( outer.f1.LB , steps[i].first );
+        box.f1.UB = std::min ( outer.f1.UB , steps[i + 1].first - 1.0 );
+        box.f2.UB = std::min ( outer.f2.UB , UncoveredBelow ( steps[i].second ) );
+        if ( box.f1.LB > box.f1.UB || box.f2.LB > box.f2.UB ) continue;
+        if ( !LPFacets.empty ( ) && !ShrinkBox ( box ) )
+        {
+            ++theStatistics->NumberOfPrunedBoxes;
+            continue;
+        }
+        boxes.push_back ( box );
+        UnexploredArea += BoxArea ( box );
+    }
+}
+
+/********************************************************************************************/
+void tpm::RunPhaseTwo ( CplexModel &theModel )
+{
+    try
+    {
+        bool OnlyOneNonDomSol = (NonDomSet.NDs.size ( ) == 1); // Check if only one solution was found in phase one
+        int triangle        = 0,   // Variable used to count the triangles
+            NumOfTriangles  = NonDomSet.NDs.size ( ) - 1;  // Variable holding the number of triangles we should process
+        // Tell cplex not to print to the console
+        theModel.cplex.setOut( theModel.env.getNullStream ( ) );
+
+        // All triangles are unexplored to begin with
+        InitUnexploredArea ( );
+
+        SlabData = BuildSlabModel ? nullptr : theModel.getModelData ( );
+        bool UseSlabs = ( Engine == ENGINE_PSM ) && ( Slabs > 1 ) && ( BuildSlabModel || SlabData ) && ( NumOfTriangles < Slabs );
+        if ( UseSlabs ) Pipeline.stop ( ); // The slabs update the non-dominated set themselves
+        std::vector< IloInt > Fixed; // Variables fixed by reduced costs in the current triangle
+
+        // loop over all supported non-dominated points
+        for ( auto it = NonDomSet.SupNDs.begin ( ); !OnlyOneNonDomSol && std::next ( it )!=NonDomSet.SupNDs.end ( ); ++it )
+        {
+            ++triangle;
+            if ( Logger::global ( ).isEnabled ( LOG_PROGRESS ) )
+            {   // The hypervolume is read by the pipeline, which owns the non-dominated set
+                double Unexplored = UnexploredArea;
+                Pipeline.submit ( [this,triangle,NumOfTriangles,Unexplored] ( ) {
+                    TPM_LOG_PROGRESS ( ProgressRate , "triangle index=" << triangle << " of=" << NumOfTriangles
+                                                      << " hv=" << NonDomSet.getHyperVolume ( )
+                                                      << " unexplored=" << Unexplored );
+                } );
+            }
+            // With fewer triangles than slabs, parallelising over the slabs of a triangle keeps the cores busy
+            bool InTime;
+            if ( ReducedCostFixing && !UseSlabs ) FixByReducedCosts ( theModel , *it , *std::next ( it ) , Fixed );
+            if ( Engine == ENGINE_EPSILON ) InTime = ProcessTriangleEpsilon ( theModel , *it , *std::next ( it ) );
+            else if ( Engine == ENGINE_BALANCED_BOX ) InTime = ProcessTriangleBalancedBox ( theModel , *it , *std::next ( it ) );
+            else if ( UseSlabs ) InTime = ProcessTriangleSlabs ( *it , *std::next ( it ) );
+            else InTime = ProcessTrianglePSM ( theModel , *it , *std::next ( it ) );
+            ReleaseFixings ( theModel , Fixed );
+            if ( !InTime ) break; // Time limit reached
+        }
+        TPM_LOG ( LOG_INFO , "frontier supported=" << NonDomSet.SupNDs.size ( ) << " non_supported=" << (NonDomSet.NDs.size ( ) - NonDomSet.SupNDs.size ( ) ) );
+        if ( !LPFacets.empty ( ) )
+        {
+            TPM_LOG ( LOG_INFO , "lp_bound pruned_triangles=" << theStatistics->NumberOfPrunedTriangles << " pruned_boxes=" << theStatistics->NumberOfPrunedBoxes );
+        }
+
+        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
+        theStatistics->NumberOfPhaseTwoSolutions = theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions;
+
+
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in RunTwoPhase in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RunTwoPhase in the tpm class : " << ie.getMessage ( )  << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+bool tpm::ProcessTrianglePSM ( CplexModel &theModel, const solution &left, const solution &right )
+{
+    try
+    {
+        CPUclock::time_point endTime;
+        std::chrono::duration<double> TimeUntilNow;
+        double  lambda1=0.0, // Weight of first objective
+                lambda2=0.0; // Weight of second objective
+        std::pair<double,double> p; // Pair used to store outcome vector of a solution
+        BOUNDS CurrentBounds;   // BOUNDS variable to hold the current bounds on the objective functions
+        BoxQueue<BOUNDS> bounds ( TakeFront , MaxBoxesInMemory ( ) ); // Pending BOUNDS. Spilled to disk beyond the memory ceiling
+        std::vector<BOUNDS> children; // New subproblems created from the current one
+        IloNumArray vals ( theModel.env );
+
+        UnexploredArea -= BoxArea ( TriangleBox ( left , right ) ); // From now on, the boxes of the triangle are counted instead
+
+        // Calculate the slope of the search direction
+        lambda1 = left.getSecond ( ) - right.getSecond ( );
+        lambda2 = right.getFirst ( ) - left.getFirst ( );
+
+        // Set the objective function coefficients according to left and right
+        theModel.setWeights ( lambda1 , lambda2 );
+
+        // Initialize the stack of subproblems
+        BOUNDS FirstBounds;
+        if ( !FirstTriangleBox ( left , right , FirstBounds ) )
+        {
+            vals.end ( );
+            return true;
+        }
+        if ( Seeds.empty ( ) )
+        {
+            bounds.push ( FirstBounds );
+            UnexploredArea += BoxArea ( FirstBounds );
+        }
+        else
+        {   // The frontier was seeded by an earlier run or phase zero. Only the boxes between its outcomes are searched
+            StaircaseBoxes ( FirstBounds , left , right , children );
+            for ( auto child = children.begin ( ); child != children.end ( ); ++child ) bounds.push ( *child );
+        }
+
+        while ( !bounds.empty ( ) )
+        {
+            // Get the first or the last element, depending on TakeFront
+            CurrentBounds = bounds.pop ( );
+            UnexploredArea -= BoxArea ( CurrentBounds );
+
+
+            theModel.setObjectiveBounds ( CurrentBounds.f1.LB , CurrentBounds.f1.UB , CurrentBounds.f2.LB , CurrentBounds.f2.UB );
+
+            theModel.setParameter ( IloCplex::Param::TimeLimit , 3600 );
+            endTime = CPUclock::now ( );
+            TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
+            if ( TimeUntilNow.count ( ) > 3600.0 )
+            {
+                UnexploredArea += BoxArea ( CurrentBounds ); // The current box was never solved
+                TimedOut = true;
+                TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
+                Pipeline.drain ( );
+                vals.end ( );
+                theStatistics->NumberOfSpilledBoxes += bounds.getNumberOfSpilledBoxes ( );
+                return false;
+            }
+            if ( Solve ( theModel , ( CurrentBounds.f1.UB - CurrentBounds.f1.LB ) * ( CurrentBounds.f2.UB - CurrentBounds.f2.LB ) , SUBPROBLEM_BOX ) )
+            {
+                // Update the Time left
+                theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes();
+
+                // If the current model has a solution, get it!
+                p.first = theModel.cplex.getValue( theModel.f1 );
+                p.second = theModel.cplex.getValue( theModel.f2 );
+                // Create a new solution. Only the outcome vector is needed to create the new boxes, so inserting it into the non-dominated set is left to the pipeline
+                theModel.cplex.getValues ( vals , theModel.AllVars );
+                std::vector< double > VarValues ( vals.getSize ( ) );
+                for ( IloInt i = 0; i < vals.getSize ( ); ++i ) VarValues[i] = vals[i];
+                auto sol = std::make_shared< solution > ( false , p , VarValues );
+                Pipeline.submit ( [this,sol] ( ) { NonDomSet.updateNDS( *sol ); } );
+                // Create two new subproblems, to the left and to the right of the current outcome vector
+                SplitBox ( CurrentBounds , p , children );
+                for ( auto child = children.begin ( ); child != children.end ( ); ++child ) bounds.push ( *child );
+            }
+        }
+        // The caller may read the non-dominated set
+        Pipeline.drain ( );
+        vals.end ( );
+        theStatistics->NumberOfSpilledBoxes += bounds.getNumberOfSpilledBoxes ( );
+        return true;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in ProcessTrianglePSM in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in ProcessTrianglePSM in the tpm class : " << ie.getMessage ( )  << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+bool tpm::ProcessTriangleEpsilon ( CplexModel &theModel, const solution &left, const solution &right )
+{
+    try
+    {
+        std::pair<double,double> p; // Pair used to store outcome vector of a solution
+        IloNumArray vals ( theModel.env );
+
+        UnexploredArea -= BoxArea ( TriangleBox ( left , right ) ); // From now on, the remaining box is counted instead
+        BOUNDS Remaining;   // Outcomes not found yet lie in this box
+        if ( !FirstTriangleBox ( left , right , Remaining ) )
+        {
+            vals.end ( );
+            return true;
+        }
+        // The corners of the triangle are known
+        Remaining.f1.LB = std::max ( Remaining.f1.LB , left.getFirst ( ) + 1.0 );
+        Remaining.f1.UB = std::min ( Remaining.f1.UB , right.getFirst ( ) - 1.0 );
+        Remaining.f2.LB = std::max ( Remaining.f2.LB , right.getSecond ( ) + 1.0 );
+        Remaining.f2.UB = std::min ( Remaining.f2.UB , left.getSecond ( ) - 1.0 );
+        if ( Remaining.f1.LB <= Remaining.f1.UB && Remaining.f2.LB <= Remaining.f2.UB ) UnexploredArea += BoxArea ( Remaining );
+
+        theModel.setParameter ( IloCplex::Param::TimeLimit , 3600 );
+        while ( Remaining.f1.LB <= Remaining.f1.UB && Remaining.f2.LB <= Remaining.f2.UB )
+        {
+            double TimeUntilNow = duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( );
+            if ( TimeUntilNow > 3600.0 )
+            {
+                TimedOut = true;
+                TPM_LOG ( LOG_WARNING , "timeout elapsed=" << TimeUntilNow );
+                Pipeline.drain ( );
+                vals.end ( );
+                return false;
+            }
+            UnexploredArea -= BoxArea ( Remaining );
+
+            // The outcome with the smallest f2 among those with f1 <= epsilon = Remaining.f1.UB, and the smallest f1 among those
+            if ( !SolveLexicographic ( theModel , Remaining , false , p ) ) break; // No more outcomes in the triangle
+            theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
+            theModel.cplex.getValues ( vals , theModel.AllVars );
+            std::vector< double > VarValues ( vals.getSize ( ) );
+            for ( IloInt i = 0; i < vals.getSize ( ); ++i ) VarValues[i] = vals[i];
+            auto sol = std::make_shared< solution > ( false , p , VarValues );
+            Pipeline.submit ( [this,sol] ( ) { NonDomSet.updateNDS( *sol ); } );
+
+            // Outcomes not found yet lie to the left of and above p
+            Remaining.f1.UB = p.first - 1.0;
+            Remaining.f2.LB = p.second + 1.0;
+            if ( !LPFacets.empty ( ) && !ShrinkBox ( Remaining ) ) break;
+            if ( Remaining.f1.LB <= Remaining.f1.UB && Remaining.f2.LB <= Remaining.f2.UB ) UnexploredArea += BoxArea ( Remaining );
+        }
+        // The caller may read the non-dominated set
+        Pipeline.drain ( );
+        vals.end ( );
+        return true;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in ProcessTriangleEpsilon in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in ProcessTriangleEpsilon in the tpm class : " << ie.getMessage ( )  << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+bool tpm::ProcessTriangleBalancedBox ( CplexModel &theModel, const solution &left, const solution &right )
+{
+    try
+    {
+        std::pair<double,double> pBottom, pTop; // Outcome vectors found in the lower and upper half of a rectangle
+        BOUNDS Rectangle, Bottom, Top;
+        // Rectangles whose upper left corner ( f1.LB , f2.UB ) and lower right corner ( f1.UB , f2.LB ) are known outcomes
+        BoxQueue<BOUNDS> rectangles ( TakeFront , MaxBoxesInMemory ( ) );
+        IloNumArray vals ( theModel.env );
+
+        // Only the interior of a rectangle may hold outcomes not found yet
+        auto Interior = [] ( BOUNDS box ) { box.f1.LB += 1.0; box.f1.UB -= 1.0; box.f2.LB += 1.0; box.f2.UB -= 1.0; return box; };
+        auto Push = [&] ( const BOUNDS &box )
+        {
+            BOUNDS inner = Interior ( box );
+            if ( inner.f1.LB > inner.f1.UB || inner.f2.LB > inner.f2.UB ) return; // No integer outcome in the interior
+            if ( !LPFacets.empty ( ) && !ShrinkBox ( inner ) )
+            {
+                ++theStatistics->NumberOfPrunedBoxes;
+                return;
+            }
+            rectangles.push ( box );
+            UnexploredArea += BoxArea ( Interior ( box ) );
+        };
+        // Finds the lexicographic minimum in box, and hands the solution to the pipeline unless it is a corner of the rectangle
+        auto Find = [&] ( BOUNDS box, bool f1First, std::pair<double,double> &p )
+        {
+            if ( !LPFacets.empty ( ) ) ShrinkBox ( box ); // The corner in the box is feasible, so the box is never emptied
+            if ( !SolveLexicographic ( theModel , box , f1First , p ) ) throw std::runtime_error ( "A box of the balanced box method holding a known outcome is infeasible" );
+            theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
+            bool corner = ( std::fabs ( p.first - Rectangle.f1.LB ) < myTol && std::fabs ( p.second - Rectangle.f2.UB ) < myTol )
+                       || ( std::fabs ( p.first - Rectangle.f1.UB ) < myTol && std::fabs ( p.second - Rectangle.f2.LB ) < myTol );
+            if ( corner ) return;
+            theModel.cplex.getValues ( vals , theModel.AllVars );
+            std::vector< double > VarValues ( vals.getSize ( ) );
+            for ( IloInt i = 0; i < vals.getSize ( ); ++i ) VarValues[i] = vals[i];
+            auto sol = std::make_shared< solution > ( false , p , VarValues );
+            Pipeline.submit ( [this,sol] ( ) { NonDomSet.updateNDS( *sol ); } );
+        };
+
+        UnexploredArea -= BoxArea ( TriangleBox ( left , right ) ); // From now on, the rectangles are counted instead
+        Push ( TriangleBox ( left , right ) );
+        theModel.setParameter ( IloCplex::Param::TimeLimit , 3600 );
+
+        while ( !rectangles.empty ( ) )
+        {
+            Rectangle = rectangles.pop ( );
+            double TimeUntilNow = duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( );
+            if ( TimeUntilNow > 3600.0 )
+            {
+                TimedOut = true;
+                TPM_LOG ( LOG_WARNING , "timeout elapsed=" << TimeUntilNow );
+                Pipeline.drain ( );
+                vals.end ( );
+                theStatistics->NumberOfSpilledBoxes += rectangles.getNumberOfSpilledBoxes ( );
+                return false;
+            }
+            UnexploredArea -= BoxArea ( Interior ( Rectangle ) );
+
+            // Lower half: the outcome with the smallest f1, which is the lower right corner if the half holds no other outcome
+            double middle = std::floor ( ( Rectangle.f2.LB + Rectangle.f2.UB ) / 2.0 );
+            Bottom = Rectangle;
+            Bottom.f2.UB = middle;
+            Find ( Bottom , true , pBottom );
+
+            // Upper half, left of pBottom: the outcome with the smallest f2, which is the upper left corner if the part holds no other outcome
+            Top = Rectangle;
+            Top.f1.UB = pBottom.first - 1.0;
+            Top.f2.LB = middle + 1.0;
+            Find ( Top , false , pTop );
+
+            // Outcomes not found yet lie between the upper left corner and pTop, or between pBottom and the lower right corner
+            BOUNDS child = Rectangle;
+            child.f1.UB = pTop.first;
+            child.f2.LB = pTop.second;
+            Push ( child );
+            child = Rectangle;
+            child.f1.LB = pBottom.first;
+            child.f2.UB = pBottom.second;
+            Push ( child );
+        }
+        // The caller may read the non-dominated set
+        Pipeline.drain ( );
+        vals.end ( );
+        theStatistics->NumberOfSpilledBoxes += rectangles.getNumberOfSpilledBoxes ( );
+        return true;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in ProcessTriangleBalancedBox in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in ProcessTriangleBalancedBox in the tpm class : " << ie.getMessage ( )  << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+bool tpm::SolveLexicographic ( CplexModel &theModel, const BOUNDS &box, bool f1First, std::pair<double,double> &p )
+{
+    // Outcomes are integral, so the secondary objective changes the augmented value by less than one over the box
+    double delta = f1First ? 1.0 / ( box.f2.UB - box.f2.LB + 2.0 ) : 1.0 / ( box.f1.UB - box.f1.LB + 2.0 );
+    if ( f1First ) theModel.setWeights ( 1.0 , delta );
+    else theModel.setWeights ( delta , 1.0 );
+    theModel.setObjectiveBounds ( box.f1.LB , box.f1.UB , box.f2.LB , box.f2.UB );
+    if ( !Solve ( theModel , ( box.f1.UB - box.f1.LB ) * ( box.f2.UB - box.f2.LB ) , SUBPROBLEM_BOX ) ) return false;
+    p.first     = theModel.cplex.getValue ( theModel.f1 );
+    p.second    = theModel.cplex.getValue ( theModel.f2 );
+    return true;
+}
+
+/********************************************************************************************/
+bool tpm::ProcessTriangleSlabs ( const solution &left, const solution &right )
+{
+    try
+    {
+        double  lambda1 = left.getSecond ( ) - right.getSecond ( ), // Weight of first objective
+                lambda2 = right.getFirst ( ) - left.getFirst ( );   // Weight of second objective
+
+        UnexploredArea -= BoxArea ( TriangleBox ( left , right ) ); // From now on, the boxes of the slabs are counted instead
+        BOUNDS FirstBounds;
+        if ( !FirstTriangleBox ( left , right , FirstBounds ) ) return true;
+
+        // Split the range of f1 into slabs of (almost) equal width. The bounds are inclusive, so the last column of a slab is searched by the slab (see SplitBox)
+        double Width = FirstBounds.f1.UB - FirstBounds.f1.LB + 1.0;
+        int k = (int) std::max ( 1.0 , std::min ( double ( Slabs ) , std::floor ( Width ) ) );
+        std::vector< std::unique_ptr< BoxQueue< BOUNDS > > > SlabBoxes;
+        for ( int j = 0; j < k; ++j ) SlabBoxes.push_back ( std::unique_ptr< BoxQueue< BOUNDS > > ( new BoxQueue< BOUNDS > ( TakeFront , ( MaxBoxesInMemory ( ) + k - 1 ) / k ) ) );
+        for ( int j = 0; j < k; ++j )
+        {
+            BOUNDS slab = FirstBounds;
+            slab.f1.LB = FirstBounds.f1.LB + std::floor ( j * Width / k );
+            slab.f1.UB = FirstBounds.f1.LB + std::floor ( ( j + 1 ) * Width / k ) - 1.0;
+            if ( j == k - 1 ) slab.f1.UB = FirstBounds.f1.UB;
+            if ( !LPFacets.empty ( ) && !ShrinkBox ( slab ) )
+            {
+                ++theStatistics->NumberOfPrunedBoxes;
+                continue;
+            }
+            SlabBoxes[j]->push ( slab );
+            UnexploredArea += BoxArea ( slab );
+        }
+        theStatistics->NumberOfSlabs += k;
+
+        // Each slab is searched by its own thread, using its own copy of the model. They share the non-dominated set.
+        // The slab threads register themselves, and this thread only waits for them, so it gives up its share of the cores meanwhile
+        std::vector< std::thread > SlabThreads;
+        ThreadBudget::global ( ).unregisterWorker ( );
+        for ( int j = 0; j < k; ++j )
+        {
+            if ( SlabBoxes[j]->empty ( ) ) continue;
+            SlabThreads.push_back ( std::thread ( &tpm::RunSlab , this , std::ref ( *SlabBoxes[j] ) , lambda1 , lambda2 , k ) );
+        }
+        for ( auto it = SlabThreads.begin ( ); it != SlabThreads.end ( ); ++it ) it->join ( );
+        ThreadBudget::global ( ).registerWorker ( );
+        for ( int j = 0; j < k; ++j ) theStatistics->NumberOfSpilledBoxes += SlabBoxes[j]->getNumberOfSpilledBoxes ( );
+        return !TimedOut;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in ProcessTriangleSlabs in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::RunSlab ( BoxQueue< BOUNDS > &boxes, double lambda1, double lambda2, int NumberOfSlabs )
+{
+    try
+    {
+        CplexModel SlabModel;
+        if ( BuildSlabModel ) BuildSlabModel ( SlabModel );
+        else SlabModel.build ( SlabData );
+        SlabModel.cplex.setOut ( SlabModel.env.getNullStream ( ) );
+        SlabModel.setParameter ( IloCplex::Param::TimeLimit , 3600 );
+        // Without a budget, the cores are split evenly between the slabs
+        if ( Threads > 0 ) SlabModel.setParameter ( IloCplex::Param::Threads , Threads );
+        else if ( !ThreadBudget::global ( ).isEnabled ( ) )
+            SlabModel.setParameter ( IloCplex::Param::Threads , std::max ( 1 , int ( std::thread::hardware_concurrency ( ) ) / NumberOfSlabs ) );
+        SlabModel.setWeights ( lambda1 , lambda2 );
+        ThreadBudget::global ( ).registerWorker ( );
+
+        IloNumArray vals ( SlabModel.env );
+        std::vector< BOUNDS > children;
+        std::pair<double,double> p;
+        while ( true )
+        {
+            BOUNDS CurrentBounds;
+            {
+                std::lock_guard< std::mutex > lock ( SharedStateMutex );
+                if ( boxes.empty ( ) || TimedOut ) break;
+                CurrentBounds = boxes.pop ( );
+                UnexploredArea -= BoxArea ( CurrentBounds );
+                // Outcomes found in the other slabs may show that part of the box is dominated
+                if ( !TightenBox ( CurrentBounds ) ) continue;
+                double TimeUntilNow = duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( );
+                if ( TimeUntilNow > 3600.0 )
+                {
+                    UnexploredArea += BoxArea ( CurrentBounds ); // The current box was never solved
+                    TimedOut = true;
+                    TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
+                    break;
+                }
+            }
+
+            SlabModel.setObjectiveBounds ( CurrentBounds.f1.LB , CurrentBounds.f1.UB , CurrentBounds.f2.LB , CurrentBounds.f2.UB );
+            if ( Solve ( SlabModel , ( CurrentBounds.f1.UB - CurrentBounds.f1.LB ) * ( CurrentBounds.f2.UB - CurrentBounds.f2.LB ) , SUBPROBLEM_BOX ) )
+            {
+                p.first = SlabModel.cplex.getValue( SlabModel.f1 );
+                p.second = SlabModel.cplex.getValue( SlabModel.f2 );
+                SlabModel.cplex.getValues ( vals , SlabModel.AllVars );
+                std::vector< double > VarValues ( vals.getSize ( ) );
+                for ( IloInt i = 0; i < vals.getSize ( ); ++i ) VarValues[i] = vals[i];
+                double nodes = SlabModel.cplex.getNnodes ( );
+
+                std::lock_guard< std::mutex > lock ( SharedStateMutex );
+                theStatistics->NumberOfBranchingNodes += nodes;
+                NonDomSet.updateNDS ( solution ( false , p , VarValues ) );
+                SplitBox ( CurrentBounds , p , children );
+                for ( auto child = children.begin ( ); child != children.end ( ); ++child ) boxes.push ( *child );
+            }
+        }
+        vals.end ( );
+        ThreadBudget::global ( ).unregisterWorker ( );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RunSlab in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in RunSlab in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+bool tpm::TightenBox ( BOUNDS &box ) const
+{
+    // The non-dominated set is sorted by increasing first (and decreasing second) objective value
+    for ( auto it = NonDomSet.NDs.begin ( ); it != NonDomSet.NDs.end ( ); ++it )
+    {
+        // An outcome left of the box dominates every outcome in the box with a larger second objective value
+        if ( it->getFirst ( ) < box.f1.LB ) box.f2.UB = std::min ( box.f2.UB , UncoveredBelow ( it->getSecond ( ) ) );
+        // An outcome below the box dominates every outcome in the box with a larger first objective value
+        if ( it->getSecond ( ) < box.f2.LB )
+        {
+            box.f1.UB = std::min ( box.f1.UB , UncoveredBelow ( it->getFirst ( ) ) );
+            break; // The following outcomes have larger first objective values
+        }
+    }
+    return box.f1.LB <= box.f1.UB && box.f2.LB <= box.f2.UB;
+}
+
+/********************************************************************************************/
+void tpm::SplitBox ( const BOUNDS &CurrentBounds, const std::pair<double,double> &p, std::vector< BOUNDS > &children )
+{
+    // Outcomes close enough to p to be covered by it are skipped. In exact mode the cut is at distance one from p
+    double f1Cut = UncoveredBelow ( p.first ),
+           f2Cut = UncoveredBelow ( p.second );
+    children.clear ( );
+    // First subproblem, to the left of the current outcome vector
+    if ( f1Cut < CurrentBounds.f1.LB || p.second +1 > CurrentBounds.f2.UB )
+    {}// The left subproblem is infeasible, and should not be added!
+    else
+    { // The left subproblem might be feasible, we create it, and se what happens
+        BOUNDS leftBounds;
+        leftBounds.f1.LB = CurrentBounds.f1.LB;
+        leftBounds.f1.UB = f1Cut;
+        leftBounds.f2.LB = p.second + 1.0;
+        leftBounds.f2.UB = CurrentBounds.f2.UB;
+        if ( LPFacets.empty ( ) || ShrinkBox ( leftBounds ) )
+        {
+            children.push_back( leftBounds );
+            UnexploredArea += BoxArea ( leftBounds );
+        }
+        else ++theStatistics->NumberOfPrunedBoxes;
+    }
+
+    // Now create the subproblem to the right. Box bounds are inclusive, and f1.UB need not be the first objective of an outcome already found
+    if ( ( f2Cut < CurrentBounds.f2.LB ) || ( p.first + 1.0 > CurrentBounds.f1.UB ) )
+    {} // The right subproblem is infeasible, and we can descard it
+    else
+    { // The right subproblem might be feasible, we create it, and se what happens.
+        BOUNDS rightBounds;
+        rightBounds.f1.LB = p.first + 1.0;
+        rightBounds.f1.UB = CurrentBounds.f1.UB;
+        rightBounds.f2.LB = CurrentBounds.f2.LB;
+        rightBounds.f2.UB = f2Cut;
+        if ( LPFacets.empty ( ) || ShrinkBox ( rightBounds ) )
+        {
+            children.push_back( rightBounds );
+            UnexploredArea += BoxArea ( rightBounds );
+        }
+        else ++theStatistics->NumberOfPrunedBoxes;
+    }
+}
+
+/********************************************************************************************/
+bool tpm::FirstTriangleBox ( const solution &left, const solution &right, BOUNDS &FirstBounds )
+{
+    FirstBounds = TriangleBox ( left , right );
+    if ( !LPFacets.empty ( ) )
+    {   // Outcomes not found yet lie in the interior of the triangle. Shrink it using the LP relaxation lower bound set. The bounds stay inclusive (see SplitBox)
+        FirstBounds.f1.LB += 1.0;
+        FirstBounds.f1.UB -= 1.0;
+        FirstBounds.f2.LB += 1.0;
+        FirstBounds.f2.UB -= 1.0;
+        if ( FirstBounds.f1.LB > FirstBounds.f1.UB || FirstBounds.f2.LB > FirstBounds.f2.UB ) return false; // No integer outcome in the interior
+        if ( !ShrinkBox ( FirstBounds ) )
+        {
+            ++theStatistics->NumberOfPrunedTriangles;
+            return false;
+        }
+    }
+    return true;
+}
+
+/********************************************************************************************/
+void tpm::RunPhaseTwoDistributed ( CplexModel &theModel )
+{
+    int ListenFD = -1;
+    try
+    {
+        struct DISTBOX{
+            BOUNDS Box;     //!< The box to search
+            double lambda1; //!< Weight of the first objective in the triangle of the box
+            double lambda2; //!< Weight of the second objective in the triangle of the box
+        };
+        std::list< DISTBOX > Queue;                             // Boxes not yet handed to a worker
+        std::vector< std::unique_ptr< LineChannel > > Workers;  // Connections to the workers. A null pointer is a worker which has left
+        std::vector< bool > Busy;                               // True if the worker is solving a box
+        std::vector< bool > Ready;                              // True if the worker has sent a valid HELLO
+        std::vector< DISTBOX > Assigned;                        // The box each worker is solving
+        std::vector< BOUNDS > children;
+        size_t Outstanding = 0;                                 // Number of boxes handed out and not yet answered
+        size_t LocalSolves = 0;                                 // Number of boxes solved by the coordinator, as no worker was ready
+        bool Stop = false;
+        std::string line;
+        CPUclock::time_point LastWorker = CPUclock::now ( );   // Last time a worker was ready
+
+        /*================================================*/
+        /*      The first box of every triangle           */
+        /*================================================*/
+        InitUnexploredArea ( );
+        for ( auto it = NonDomSet.SupNDs.begin ( ); NonDomSet.SupNDs.size ( ) > 1 && std::next ( it )!=NonDomSet.SupNDs.end ( ); ++it )
+        {
+            DISTBOX first;
+            UnexploredArea -= BoxArea ( TriangleBox ( *it , *std::next ( it ) ) ); // From now on, the boxes of the triangle are counted instead
+            if ( !FirstTriangleBox ( *it , *std::next ( it ) , first.Box ) ) continue;
+            first.lambda1 = it->getSecond ( ) - std::next ( it )->getSecond ( );
+            first.lambda2 = std::next ( it )->getFirst ( ) - it->getFirst ( );
+            Queue.push_back ( first );
+            UnexploredArea += BoxArea ( first.Box );
+        }
+
+        IloInt NumOfVars = theModel.AllVars.getSize ( ); // Workers must hold a model with as many variables
+        ListenFD = LineChannel::listenOn ( CoordinatorPort , CoordinatorAddress );
+        TPM_LOG ( LOG_INFO , "coordinator address=" << CoordinatorAddress << " port=" << CoordinatorPort << " triangles=" << Queue.size ( ) );
+
+        // Disconnects a worker. A box it was solving is put back in the queue
+        auto DropWorker = [&] ( size_t w, const char *reason )
+        {
+            if ( Busy[w] )
+            {
+                Busy[w] = false;
+                --Outstanding;
+                if ( !Stop ) Queue.push_front ( Assigned[w] );
+                UnexploredArea += BoxArea ( Assigned[w].Box );
+            }
+            Workers[w].reset ( );
+            TPM_LOG ( LOG_WARNING , "worker_left worker=" << w + 1 << " reason=" << reason );
+        };
+
+        while ( !Queue.empty ( ) || Outstanding > 0 )
+        {
+            /*================================================*/
+            /*      Check the time limit                      */
+            /*================================================*/
+            double time = duration_cast<std::chrono::duration<double>>( CPUclock::now ( ) - PhaseTwoStartTime ).count ( );
+            double TimeUntilNow = duration_cast<std::chrono::duration<double>>( CPUclock::now ( ) - StartTime ).count ( );
+            if ( !Stop && ( totalTime < time || TimeUntilNow > 3600.0 ) )
+            {   // Boxes in the queue and boxes being solved remain counted as unexplored
+                TimedOut = Stop = true;
+                TPM_LOG ( LOG_WARNING , "timeout elapsed=" << duration_cast< duration < double > > ( CPUclock::now ( ) - StartTime ).count ( ) );
+                Queue.clear ( );
+            }
+            if ( Stop && Outstanding == 0 ) break;
+
+            /*================================================*/
+            /*      Solve a box here if no worker is ready    */
+            /*================================================*/
+            bool HaveWorker = false;
+            for ( size_t w = 0; w < Workers.size ( ); ++w ) HaveWorker = HaveWorker || ( Workers[w] && Ready[w] );
+            if ( HaveWorker ) LastWorker = CPUclock::now ( );
+            bool SolveHere = !Stop && !Queue.empty ( ) && duration_cast<std::chrono::duration<double>>( CPUclock::now ( ) - LastWorker ).count ( ) > WorkerWait;
+            if ( SolveHere )
+            {
+                DISTBOX local = TakeFront ? Queue.front ( ) : Queue.back ( );
+                if ( TakeFront ) Queue.pop_front ( );
+                else Queue.pop_back ( );
+                UnexploredArea -= BoxArea ( local.Box );
+                ++LocalSolves;
+                theModel.setParameter ( IloCplex::Param::TimeLimit , 3600 );
+                theModel.setWeights ( local.lambda1 , local.lambda2 );
+                theModel.setObjectiveBounds ( local.Box.f1.LB , local.Box.f1.UB , local.Box.f2.LB , local.Box.f2.UB );
+                if ( Solve ( theModel , ( local.Box.f1.UB - local.Box.f1.LB ) * ( local.Box.f2.UB - local.Box.f2.LB ) , SUBPROBLEM_BOX ) )
+                {
+                    theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
+                    std::pair<double,double> p ( theModel.cplex.getValue ( theModel.f1 ) , theModel.cplex.getValue ( theModel.f2 ) );
+                    std::vector<double> VarValues ( theModel.AllVars.getSize ( ) );
+                    for ( IloInt i = 0; i < theModel.AllVars.getSize ( ); ++i ) VarValues[i] = theModel.cplex.getValue ( theModel.AllVars[i] );
+                    NonDomSet.updateNDS ( solution ( false , p , VarValues ) );
+                    SplitBox ( local.Box , p , children );
+                    for ( auto child = children.begin ( ); child != children.end ( ); ++child )
+                    {
+                        DISTBOX next = local;
+                        next.Box = *child;
+                        Queue.push_back ( next );
+                    }
+                }
+            }
+
+            /*================================================*/
+            /*      Hand boxes to idle workers                */
+            /*================================================*/
+            for ( size_t w = 0; w < Workers.size ( ) && !Queue.empty ( ); ++w )
+            {
+                if ( !Workers[w] || Busy[w] || !Ready[w] ) continue;
+                if ( TakeFront )
+                {
+                    Assigned[w] = Queue.front ( );
+                    Queue.pop_front ( );
+                }
+                else
+                {
+                    Assigned[w] = Queue.back ( );
+                    Queue.pop_back ( );
+                }
+                UnexploredArea -= BoxArea ( Assigned[w].Box );
+                std::ostringstream message;
+                message.precision ( 17 );
+                message << "BOX " << Assigned[w].lambda1 << " " << Assigned[w].lambda2 << " "
+                        << Assigned[w].Box.f1.LB << " " << Assigned[w].Box.f1.UB << " "
+                        << Assigned[w].Box.f2.LB << " " << Assigned[w].Box.f2.UB;
+                if ( Workers[w]->sendLine ( message.str ( ) ) )
+                {
+                    Busy[w] = true;
+                    ++Outstanding;
+                }
+                else
+                {   // The worker has left. Put the box back
+                    Queue.push_front ( Assigned[w] );
+                    UnexploredArea += BoxArea ( Assigned[w].Box );
+                    Workers[w].reset ( );
+                }
+            }
+
+            /*================================================*/
+            /*      Wait for new workers and answers          */
+            /*================================================*/
+            std::vector< pollfd > fds ( 1 );
+            std::vector< size_t > owner ( 1 , 0 );
+            fds[0].fd = ListenFD;
+            fds[0].events = POLLIN;
+            for ( size_t w = 0; w < Workers.size ( ); ++w )
+            {
+                if ( !Workers[w] ) continue;
+                pollfd fd;
+                fd.fd = Workers[w]->getFD ( );
+                fd.events = POLLIN;
+                fds.push_back ( fd );
+                owner.push_back ( w );
+            }
+            if ( poll ( fds.data ( ) , fds.size ( ) , SolveHere ? 0 : 1000 ) <= 0 ) continue; // Do not wait between the boxes solved here
+
+            if ( fds[0].revents & POLLIN )
+            {
+                int fd = LineChannel::acceptOn ( ListenFD );
+                if ( fd >= 0 )
+                {
+                    Workers.push_back ( std::unique_ptr< LineChannel > ( new LineChannel ( fd ) ) );
+                    Busy.push_back ( false );
+                    Ready.push_back ( false );
+                    Assigned.push_back ( DISTBOX ( ) );
+                    TPM_LOG ( LOG_INFO , "worker_connected worker=" << Workers.size ( ) );
+                }
+            }
+            for ( size_t k = 1; k < fds.size ( ); ++k )
+            {
+                if ( !( fds[k].revents & ( POLLIN | POLLHUP | POLLERR ) ) ) continue;
+                size_t w = owner[k];
+                if ( !Workers[w]->receive ( ) )
+                {   // The worker has left. If it was solving a box, the box is handed to another worker
+                    DropWorker ( w , "closed" );
+                    continue;
+                }
+                while ( Workers[w] && Workers[w]->nextLine ( line ) )
+                {
+                    std::istringstream answer ( line );
+                    std::string command;
+                    answer >> command;
+                    if ( command == "HELLO" )
+                    {   // The worker must hold the same instance. Only the number of variables can be checked cheaply
+                        long long n = -1;
+                        answer >> n;
+                        if ( !answer || n != NumOfVars ) DropWorker ( w , "hello" );
+                        else Ready[w] = true;
+                        continue;
+                    }
+                    if ( command != "SOL" && command != "INF" ) continue; // A message this version does not know
+                    if ( !Ready[w] || !Busy[w] )
+                    {
+                        DropWorker ( w , "unexpected" );
+                        continue;
+                    }
+                    double nodes = 0.0;
+                    answer >> nodes;
+                    if ( !answer || !( nodes >= 0.0 ) )
+                    {
+                        DropWorker ( w , "malformed" );
+                        continue;
+                    }
+                    if ( command == "INF" )
+                    {
+                        Busy[w] = false;
+                        --Outstanding;
+                        ++theStatistics->NumberOfSolves;
+                        theStatistics->NumberOfBranchingNodes += nodes;
+                        continue;
+                    }
+
+                    // Read the solution, and check it before it is trusted. A bad answer is dropped, and the box is solved again
+                    std::pair<double,double> p;
+                    long long n = -1;
+                    answer >> p.first >> p.second >> n;
+                    if ( !answer || n != NumOfVars )
+                    {
+                        DropWorker ( w , "malformed" );
+                        continue;
+                    }
+                    std::vector<double> VarValues ( n );
+                    for ( long long i = 0; i < n; ++i ) answer >> VarValues[i];
+                    answer >> std::ws;
+                    if ( answer.fail ( ) || !answer.eof ( ) )
+                    {
+                        DropWorker ( w , "malformed" );
+                        continue;
+                    }
+                    const BOUNDS &box = Assigned[w].Box;
+                    if ( !( p.first >= box.f1.LB - myTol && p.first <= box.f1.UB + myTol && p.second >= box.f2.LB - myTol && p.second <= box.f2.UB + myTol ) )
+                    {
+                        DropWorker ( w , "outside_box" );
+                        continue;
+                    }
+                    Busy[w] = false;
+                    --Outstanding;
+                    ++theStatistics->NumberOfSolves;
+                    theStatistics->NumberOfBranchingNodes += nodes;
+                    NonDomSet.updateNDS ( solution ( false , p , VarValues ) );
+
+                    // Create the new subproblems. They may be handed to any idle worker
+                    SplitBox ( Assigned[w].Box , p , children );
+                    for ( auto child = children.begin ( ); child != children.end ( ); ++child )
+                    {
+                        DISTBOX next = Assigned[w];
+                        next.Box = *child;
+                        if ( !Stop ) Queue.push_back ( next ); // After the time limit, the box is never solved and remains counted as unexplored
+                    }
+                    TPM_LOG_PROGRESS ( ProgressRate , "distributed solutions=" << NonDomSet.NDs.size ( )
+                                                      << " queue=" << Queue.size ( )
+                                                      << " hv=" << NonDomSet.getHyperVolume ( )
+                                                      << " unexplored=" << UnexploredArea );
+                }
+            }
+        }
+
+        // Tell the workers we are done
+        for ( size_t w = 0; w < Workers.size ( ); ++w )
+        {
+            if ( Workers[w] ) Workers[w]->sendLine ( "END" );
+        }
+        close ( ListenFD );
+
+        TPM_LOG ( LOG_INFO , "coordinator local_solves=" << LocalSolves );
+        TPM_LOG ( LOG_INFO , "frontier supported=" << NonDomSet.SupNDs.size ( ) << " non_supported=" << (NonDomSet.NDs.size ( ) - NonDomSet.SupNDs.size ( ) ) );
+        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
+        theStatistics->NumberOfPhaseTwoSolutions = theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions;
+    }
+    catch ( std::exception &e )
+    {
+        if ( ListenFD >= 0 ) close ( ListenFD );
+        std::cerr << "Exception in RunPhaseTwoDistributed in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        if ( ListenFD >= 0 ) close ( ListenFD );
+        std::cerr << "IloException in RunPhaseTwoDistributed in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+int tpm::RUNWorker ( CplexModel &theModel, const std::string &host, int port )
+{
+    MODELSTATE InitialState;
+    try
+    {
+        reset ( );
+        ThreadBudget::global ( ).registerWorker ( );
+        theModel.synchronize ( );
+        SaveModelState ( theModel , InitialState );
+        theModel.setParameter ( IloCplex::Param::Threads , Threads );
+        theModel.setParameter ( IloCplex::Param::TimeLimit , 3600 );
+        theModel.cplex.setOut( theModel.env.getNullStream ( ) );
+
+        LineChannel Coordinator;
+        Coordinator.connectTo ( host , port );
+        Coordinator.sendLine ( "HELLO " + std::to_string ( (long long) theModel.AllVars.getSize ( ) ) );
+
+        IloNumArray vals ( theModel.env );
+        std::string line;
+        while ( Coordinator.readLine ( line ) )
+        {
+            std::istringstream request ( line );
+            std::string command;
+            request >> command;
+            if ( command == "END" ) break;
+            if ( command != "BOX" ) continue;
+
+            double lambda1, lambda2;
+            BOUNDS box;
+            request >> lambda1 >> lambda2 >> box.f1.LB >> box.f1.UB >> box.f2.LB >> box.f2.UB;
+            if ( !request )
+            {   // Leave rather than answer a box we could not read. The coordinator hands the box to another worker
+                TPM_LOG ( LOG_WARNING , "worker box=malformed" );
+                break;
+            }
+            theModel.setWeights ( lambda1 , lambda2 );
+            theModel.setObjectiveBounds ( box.f1.LB , box.f1.UB , box.f2.LB , box.f2.UB );
+
+            std::ostringstream answer;
+            answer.precision ( 17 );
+            if ( Solve ( theModel , ( box.f1.UB - box.f1.LB ) * ( box.f2.UB - box.f2.LB ) , SUBPROBLEM_BOX ) )
+            {
+                theModel.cplex.getValues ( vals , theModel.AllVars );
+                answer  << "SOL " << theModel.cplex.getNnodes ( ) << " "
+                        << theModel.cplex.getValue ( theModel.f1 ) << " "
+                        << theModel.cplex.getValue ( theModel.f2 ) << " "
+                        << vals.getSize ( );
+                for ( IloInt i = 0; i < vals.getSize ( ); ++i ) answer << " " << vals[i];
+            }
+            else answer << "INF " << theModel.cplex.getNnodes ( );
+            if ( !Coordinator.sendLine ( answer.str ( ) ) ) break;
+        }
+        vals.end ( );
+        ThreadBudget::global ( ).unregisterWorker ( );
+        RestoreModelState ( theModel , InitialState );
+        TPM_LOG ( LOG_INFO , "worker solves=" << theStatistics->NumberOfSolves );
+        Logger::global ( ).flush ( );
+        return 0;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in RUNWorker in the tpm class : " << e.what ( ) << std::endl;
+        ThreadBudget::global ( ).unregisterWorker ( );
+        RestoreModelState ( theModel , InitialState );
+        return 102;
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RUNWorker in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::RunPhaseTwoRanking( CplexModel &theModel )
+{
+    try
+    {
+        bool OnlyOneNonDomSol = (NonDomSet.NDs.size ( ) == 1);
+        int     triangle = 0,
+                NumOfTriangles = NonDomSet.NDs.size ( ) - 1;
+        std::vector< IloInt > Fixed; // Variables fixed by reduced costs in the current triangle
+
+        if ( !OnlyOneNonDomSol )
+        {
+            InitUnexploredArea ( );
+            for ( auto SupIt = NonDomSet.SupNDs.begin (); std::next( SupIt ) != NonDomSet.SupNDs.end ( ); ++SupIt )
+            {
+                ++triangle;
+                TPM_LOG_PROGRESS ( ProgressRate , "triangle index=" << triangle << " of=" << NumOfTriangles );
+                if ( ReducedCostFixing ) FixByReducedCosts ( theModel , *SupIt , *std::next ( SupIt ) , Fixed );
+                bool InTime = ProcessTriangleRanking ( theModel , *SupIt , *std::next ( SupIt ) );
+                ReleaseFixings ( theModel , Fixed );
+                if ( !InTime ) break; // Time limit reached
+            }
+        }
+        theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
+        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
+        theStatistics->NumberOfPhaseTwoSolutions = theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions;
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RunPhaseTwoRanking in the tpm class : " << ie.getMessage ( ) << std::endl;
+    }
     catch ( std::exception &e )
     {
         std::cerr << "Exception in RunPhaseTwoRanking in the tpm class : " << e.what ( ) << std::endl;
@@ -660,6 +2246,557 @@ void tpm::RunPhaseTwoRanking( CplexModel &theModel )
 
 }
 
+/********************************************************************************************/
+bool tpm::ProcessTriangleRanking ( CplexModel &theModel, const solution &left, const solution &right )
+{
+    IloInt NumOfVars = theModel.AllVars.getSize ( ); // Variable used to store the number of variables in the current model
+    double  f1_bound=0.0,// Upper bound on objective 1
+            f2_bound=0.0,// Upper bound on objective 2
+            lambda1=0.0, // Weight of first objective
+            lambda2=0.0, // Weight of second objective
+            LNP    =0.0, // Local Nadir point value wrt the current weight vector
+            WLNP   =0.0, // Worst local Nadir point wrt the current weight vector
+            ObjV   =0.0; // Objective function value of cplex.
+    IloExpr NoGood = IloExpr( theModel.env ); // IloExpression used to build the no good inequalities
+    IloRangeArray NoGoods = IloRangeArray ( theModel.env ); // All no good inequalities added in the triangle, so they can be removed again when we are done
+    struct NOGOODGUARD{
+        IloModel &Model;
+        IloRangeArray &Cuts;
+        ~NOGOODGUARD ( )
+        {   // The no good inequalities only cut off outcomes inside this triangle. They are removed however the function is left
+            try
+            {
+                Model.remove ( Cuts );
+                Cuts.endElements ( );
+                Cuts.end ( );
+            }
+            catch ( IloException &ie )
+            {
+                std::cerr << "IloException while removing the no good inequalities in the tpm class : " << ie.getMessage ( ) << std::endl;
+            }
+        }
+    } Guard = { theModel.model , NoGoods };
+    IloNumArray vals ( theModel.env ); // Values of the variables in the current solution
+    std::pair<double,double> p; // Pair used to store outcome vector of a solution
+    std::vector<double> Sol(NumOfVars), oldSol(NumOfVars);
+    bool InTime = true;
+    try
+    {
+        // Retrieve the bound of the current triangle
+        f1_bound = right.getFirst ( ) - 1.0;
+        f2_bound = left.getSecond ( ) - 1.0;
+        // Set the bound in the cplex model
+        if ( LPFacets.empty ( ) )
+        {
+            theModel.setObjectiveBounds ( left.getFirst ( ) , f1_bound , right.getSecond ( ) , f2_bound );
+        }
+        else
+        {   // Outcomes not found yet lie in the interior of the triangle. Shrink it using the LP relaxation lower bound set
+            BOUNDS TriangleBounds;
+            TriangleBounds.f1.LB = left.getFirst ( ) + 1.0;
+            TriangleBounds.f1.UB = f1_bound;
+            TriangleBounds.f2.LB = right.getSecond ( ) + 1.0;
+            TriangleBounds.f2.UB = f2_bound;
+            bool Empty = ( TriangleBounds.f1.LB > TriangleBounds.f1.UB || TriangleBounds.f2.LB > TriangleBounds.f2.UB ); // No integer outcome in the interior
+            if ( !Empty && !ShrinkBox ( TriangleBounds ) )
+            {
+                ++theStatistics->NumberOfPrunedTriangles;
+                Empty = true;
+            }
+            if ( Empty )
+            {
+                UnexploredArea -= BoxArea ( TriangleBox ( left , right ) );
+                NoGood.end ( );
+                vals.end ( );
+                return true;
+            }
+            theModel.setObjectiveBounds ( TriangleBounds.f1.LB , TriangleBounds.f1.UB , TriangleBounds.f2.LB , TriangleBounds.f2.UB );
+        }
+
+        // Calculate the slope of the search direction
+        lambda1 = left.getSecond ( ) - right.getSecond ( );
+        lambda2 = right.getFirst ( ) - left.getFirst ( );
+        // Set the objective function coefficients according to left and right
+        theModel.setWeights ( lambda1 , lambda2 );
+
+        // Set time limit
+        theModel.setParameter ( IloCplex::ClockType , 2 );
+        theModel.setParameter ( IloCplex::Param::TimeLimit , totalTime );
+
+        // As long as cplex solves the problem, we continue to rank
+        while ( Solve ( theModel , ( f1_bound - left.getFirst ( ) ) * ( f2_bound - right.getSecond ( ) ) , SUBPROBLEM_RANKING ) )
+        {
+            ++RankingIterations; // Iterations counter is incremented
+            // The worst local nadir point needs the non-dominated set updated with the previous solution. The update ran while cplex solved
+            Pipeline.drain ( );
+
+            /*=====================================================*/
+            /*      Calculate the total time consumption and       */
+            /*      to the time limit                              */
+            /*=====================================================*/
+            auto nowTime = CPUclock::now ( );
+            double time = duration_cast<std::chrono::duration<double>>( nowTime - PhaseTwoStartTime ).count ( );
+            if ( totalTime < time )
+            {
+                TimedOut = true;
+                InTime = false;
+                break;
+            }
+
+            theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes ( );
+            // Retrieve the info of the current solution!
+            p.first = theModel.cplex.getValue( theModel.f1 );
+            p.second = theModel.cplex.getValue( theModel.f2 );
+            ObjV = theModel.cplex.getObjValue ( );
+
+            // Calculate the worst local NAdir point in the current triangle
+            WLNP = 0.0;
+            for ( auto it = NonDomSet.NDs.begin (); std::next(it)!= NonDomSet.NDs.end ( ); ++it )
+            {
+                if ( std::next(it)->getFirst ( ) > f1_bound ) break;
+                else if ( it->getFirst ( ) >= left.getFirst ( ) )
+                {
+                    LNP = lambda1 * std::next(it)->getFirst ( ) + lambda2 * (it->getSecond ( ) );
+                    if ( LNP > WLNP ) WLNP = LNP;
+                }
+            }
+
+            // Retreive the current solution, and build the no good inequality
+            theModel.cplex.getValues ( vals , theModel.AllVars );
+            for ( int var = 0; var<NumOfVars; ++ var )
+            {
+                oldSol[var] = Sol[var];
+                if ( vals[var] >= 0.5 )
+                {
+                    Sol[var] = 1;
+                    NoGood += (1 - theModel.AllVars[var] );
+                }
+                else
+                {
+                    Sol[var] = 0;
+                    NoGood += theModel.AllVars[var];
+                }
+            }
+            // Create a new solution. Updating the non-dominated set and printing the progress is left to the pipeline
+            auto sol = std::make_shared< solution > ( false , p , Sol );
+            Pipeline.submit ( [this,sol] ( ) { NonDomSet.updateNDS( *sol ); } );
+
+            // Add the no-good inequality and  clear the iloexpr
+            NoGoods.add ( NoGood >= 1 );
+            theModel.model.add ( NoGoods[NoGoods.getSize ( ) - 1] );
+            NoGood.clear ( );
+
+            // Log the progress. The hypervolume is read by the pipeline, which owns the non-dominated set
+            if ( Logger::global ( ).isEnabled ( LOG_PROGRESS ) )
+            {
+                unsigned long it = RankingIterations;
+                std::vector<double> current = Sol, previous = oldSol;
+                Pipeline.submit ( [this,it,WLNP,ObjV,current,previous] ( ) {
+                    // Calculate the hamming distance between the current and the previous solutions
+                    double Diff = 0;
+                    for ( size_t i=0; i<current.size ( ); ++i )
+                    {
+                        Diff += std::max ( current[i] - previous[i] , previous[i] - current[i] );
+                    }
+                    TPM_LOG_PROGRESS ( ProgressRate , "ranking it=" << it
+                                                      << " ub=" << WLNP
+                                                      << " lb=" << ObjV
+                                                      << " gap=" << ( WLNP - ObjV ) / ObjV
+                                                      << " diff=" << Diff
+                                                      << " hv=" << NonDomSet.getHyperVolume ( )
+                                                      << " time_limit=" << totalTime );
+                } );
+            }
+            // If the value of the worst local Nadir point exceeds the current objective function value, we can stop the search in the current trianle
+            if ( ObjV >= WLNP ) break;
+        }
+        if ( InTime ) UnexploredArea -= BoxArea ( TriangleBox ( left , right ) ); // The triangle is done
+
+        // The caller may read the non-dominated set
+        Pipeline.drain ( );
+        NoGood.end ( );
+        vals.end ( );
+        return InTime; // Guard removes the no good inequalities before the next triangle
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in ProcessTriangleRanking in the tpm class : " << ie.getMessage ( ) << std::endl;
+        Pipeline.drain ( );
+        exit ( EXIT_FAILURE ); // Returning false would read as the time limit, and the frontier would be reported as complete
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in ProcessTriangleRanking in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::RunPhaseTwoAdaptive ( CplexModel &theModel )
+{
+    try
+    {
+        bool OnlyOneNonDomSol = (NonDomSet.NDs.size ( ) == 1);
+        int triangle        = 0,
+            NumOfTriangles  = NonDomSet.NDs.size ( ) - 1;
+        theModel.cplex.setOut( theModel.env.getNullStream ( ) );
+
+        // Before any triangle is observed, both strategies are assumed to use the average solve time of phase one
+        double PhaseOneSolveTime = theStatistics->PhaseOneTime / std::max ( 1ul , theStatistics->NumberOfSolves );
+        PSMModel.SecondsPerSolve = RankingModel.SecondsPerSolve = PhaseOneSolveTime;
+        PSMModel.SolvesPerPoint     = 2.0; // Each outcome found by the PSM method creates two new boxes
+        RankingModel.SolvesPerPoint = 1.5; // Each outcome ranked is a new outcome, but some ranked outcomes are dominated
+        PSMModel.Observations = RankingModel.Observations = 0;
+        PointsPerWidth = 0.5;
+        std::vector< IloInt > Fixed; // Variables fixed by reduced costs in the current triangle
+
+        InitUnexploredArea ( );
+        for ( auto it = NonDomSet.SupNDs.begin ( ); !OnlyOneNonDomSol && std::next ( it )!=NonDomSet.SupNDs.end ( ); ++it )
+        {
+            const solution &left = *it, &right = *std::next ( it );
+
+            /*================================================*/
+            /*      Predict the cost of each strategy         */
+            /*================================================*/
+            double Width    = std::min ( right.getFirst ( ) - left.getFirst ( ) , left.getSecond ( ) - right.getSecond ( ) ); // At most Width - 1 outcomes fit inside the triangle
+            double Points   = 1.0 + PointsPerWidth * std::max ( 0.0 , Width - 1.0 );
+            double Gap      = TriangleLPGap ( left , right );
+            double CostPSM  = PSMModel.SecondsPerSolve * ( PSMModel.SolvesPerPoint * Points + 1.0 );
+            double CostRank = RankingModel.SecondsPerSolve * ( RankingModel.SolvesPerPoint * Points * ( 1.0 + Gap ) + 1.0 );
+            // A strategy never tried is predicted optimistically, so it is eventually tried
+            if ( PSMModel.Observations == 0 ) CostPSM *= 0.5;
+            if ( RankingModel.Observations == 0 ) CostRank *= 0.5;
+            bool UseRanking = ( CostRank < CostPSM );
+
+            ++triangle;
+            TPM_LOG_PROGRESS ( ProgressRate , "triangle index=" << triangle << " of=" << NumOfTriangles
+                                              << " strategy=" << ( UseRanking ? "ranking" : "psm" )
+                                              << " psm_cost=" << CostPSM
+                                              << " ranking_cost=" << CostRank
+                                              << " hv=" << NonDomSet.getHyperVolume ( ) );
+
+            /*================================================*/
+            /*      Solve the triangle and observe the cost   */
+            /*================================================*/
+            size_t PointsBefore         = NonDomSet.NDs.size ( );
+            unsigned long SolvesBefore  = theStatistics->NumberOfSolves;
+            auto TriangleStart          = CPUclock::now ( );
+            if ( ReducedCostFixing ) FixByReducedCosts ( theModel , left , right , Fixed );
+            bool InTime = UseRanking ? ProcessTriangleRanking ( theModel , left , right ) : ProcessTrianglePSM ( theModel , left , right );
+            ReleaseFixings ( theModel , Fixed );
+            double Seconds              = duration_cast< duration < double > > ( CPUclock::now ( ) - TriangleStart ).count ( );
+            double Solves               = theStatistics->NumberOfSolves - SolvesBefore;
+            double Found                = std::max ( 0.0 , double ( NonDomSet.NDs.size ( ) ) - double ( PointsBefore ) );
+            if ( UseRanking ) ++theStatistics->NumberOfRankingTriangles;
+            else ++theStatistics->NumberOfPSMTriangles;
+            if ( !InTime ) break;
+
+            /*================================================*/
+            /*      Update the cost model                     */
+            /*================================================*/
+            const double alpha = 0.3; // Weight of the newest observation
+            STRATEGYMODEL &Model = UseRanking ? RankingModel : PSMModel;
+            if ( Solves > 0 )
+            {
+                Model.SecondsPerSolve = ( Model.Observations == 0 ) ? Seconds / Solves : ( 1.0 - alpha ) * Model.SecondsPerSolve + alpha * Seconds / Solves;
+                if ( Found > 0 )
+                {
+                    double PerPoint = ( Solves - 1.0 ) / ( Found * ( UseRanking ? ( 1.0 + Gap ) : 1.0 ) );
+                    Model.SolvesPerPoint = ( Model.Observations == 0 ) ? PerPoint : ( 1.0 - alpha ) * Model.SolvesPerPoint + alpha * PerPoint;
+                }
+                ++Model.Observations;
+            }
+            if ( Width > 1.0 ) PointsPerWidth = ( 1.0 - alpha ) * PointsPerWidth + alpha * Found / ( Width - 1.0 );
+        }
+
+        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
+        theStatistics->NumberOfPhaseTwoSolutions = theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in RunPhaseTwoAdaptive in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RunPhaseTwoAdaptive in the tpm class : " << ie.getMessage ( )  << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+double tpm::TriangleLPGap ( const solution &left, const solution &right ) const
+{
+    if ( LPExtremePoints.empty ( ) ) return 0.0;
+    double lambda1  = left.getSecond ( ) - right.getSecond ( );
+    double lambda2  = right.getFirst ( ) - left.getFirst ( );
+    double Depth    = lambda1 * lambda2; // Difference in weighted value between the local nadir point and the supported outcomes
+    if ( Depth <= 0.0 ) return 0.0;
+    double LPMin = std::numeric_limits<double>::max ( );
+    for ( auto it = LPExtremePoints.begin ( ); it != LPExtremePoints.end ( ); ++it )
+    {
+        LPMin = std::min ( LPMin , lambda1 * it->first + lambda2 * it->second );
+    }
+    return std::max ( 0.0 , lambda1 * left.getFirst ( ) + lambda2 * left.getSecond ( ) - LPMin ) / Depth;
+}
+
+/********************************************************************************************/
+void tpm::FixByReducedCosts ( CplexModel &theModel, const solution &left, const solution &right, std::vector< IloInt > &fixed )
+{
+    fixed.clear ( );
+    try
+    {
+        double  lambda1 = left.getSecond ( ) - right.getSecond ( ), // Weights of the triangle
+                lambda2 = right.getFirst ( ) - left.getFirst ( ),
+                Nadir   = lambda1 * right.getFirst ( ) + lambda2 * left.getSecond ( ); // No outcome in the triangle has a larger weighted value
+        BOUNDS box = TriangleBox ( left , right );
+        IloNumArray vals ( theModel.env ), costs ( theModel.env );
+
+        theModel.relax ( );
+        theModel.setWeights ( lambda1 , lambda2 );
+        theModel.setObjectiveBounds ( box.f1.LB , box.f1.UB , box.f2.LB , box.f2.UB );
+        if ( !Solve ( theModel , BoxArea ( box ) , SUBPROBLEM_LP ) )
+        {
+            theModel.unrelax ( );
+            vals.end ( );
+            costs.end ( );
+            return;
+        }
+        double ObjV = theModel.cplex.getObjValue ( );
+        theModel.cplex.getValues ( vals , theModel.AllVars );
+        theModel.cplex.getReducedCosts ( costs , theModel.AllVars );
+        theModel.unrelax ( );
+
+        /*==========================================================*/
+        /*      Fix the binaries which cannot leave their LP value  */
+        /*==========================================================*/
+        IloNumVarArray FixedVars ( theModel.env );
+        IloNumArray Values ( theModel.env );
+        for ( IloInt j = 0; j < theModel.AllVars.getSize ( ); ++j )
+        {
+            const IloNumVar &x = theModel.AllVars[j];
+            if ( x.getType ( ) == ILOFLOAT || x.getLB ( ) != 0.0 || x.getUB ( ) != 1.0 ) continue; // Binaries only
+            double Value;
+            if ( vals[j] <= myZero && costs[j] > 0.0 ) Value = 0.0;
+            else if ( vals[j] >= myOne && costs[j] < 0.0 ) Value = 1.0;
+            else continue;
+            if ( ObjV + std::fabs ( costs[j] ) <= Nadir + myTol ) continue; // Changing the value may still give an outcome inside the triangle
+            FixedVars.add ( x );
+            Values.add ( Value );
+            fixed.push_back ( j );
+        }
+        if ( !fixed.empty ( ) ) FixedVars.setBounds ( Values , Values );
+        theStatistics->NumberOfFixedVariables += fixed.size ( );
+        TPM_LOG ( LOG_DEBUG , "rc_fixing lp=" << ObjV << " nadir=" << Nadir << " fixed=" << fixed.size ( ) << " of=" << theModel.AllVars.getSize ( ) );
+        FixedVars.end ( );
+        Values.end ( );
+        vals.end ( );
+        costs.end ( );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in FixByReducedCosts in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in FixByReducedCosts in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::ReleaseFixings ( CplexModel &theModel, std::vector< IloInt > &fixed )
+{
+    if ( fixed.empty ( ) ) return;
+    try
+    {
+        IloNumVarArray FixedVars ( theModel.env );
+        IloNumArray LBs ( theModel.env ), UBs ( theModel.env );
+        for ( auto j = fixed.begin ( ); j != fixed.end ( ); ++j )
+        {
+            FixedVars.add ( theModel.AllVars[*j] );
+            LBs.add ( 0.0 );
+            UBs.add ( 1.0 );
+        }
+        FixedVars.setBounds ( LBs , UBs );
+        FixedVars.end ( );
+        LBs.end ( );
+        UBs.end ( );
+        fixed.clear ( );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in ReleaseFixings in the tpm class : " << ie.getMessage ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::InitUnexploredArea ( )
+{
+    UnexploredArea = 0.0;
+    for ( auto it = NonDomSet.SupNDs.begin ( ); NonDomSet.SupNDs.size ( ) > 1 && std::next ( it )!=NonDomSet.SupNDs.end ( ); ++it )
+    {
+        UnexploredArea += BoxArea ( TriangleBox ( *it , *std::next ( it ) ) );
+    }
+}
+
+/********************************************************************************************/
+void tpm::RunPhaseTwoRepresentation ( CplexModel &theModel )
+{
+    try
+    {
+        struct REPBOX{
+            BOUNDS Box;
+            double Gain;
+            bool operator< ( const REPBOX &other ) const { return Gain < other.Gain; }
+        }; // A box together with the largest hypervolume an outcome in it can add
+
+        std::priority_queue< REPBOX > boxes;   // Boxes, largest gain first
+        std::pair<double,double> p;             // Pair used to store outcome vector of a solution
+        std::vector<double> VarValues;
+        CPUclock::time_point endTime;
+        std::chrono::duration<double> TimeUntilNow;
+        theModel.cplex.setOut( theModel.env.getNullStream ( ) );
+
+        // Pushes a box on the queue, unless the LP relaxation lower bound set shows it is empty
+        auto PushBox = [&] ( BOUNDS box )
+        {
+            if ( box.f1.LB > box.f1.UB || box.f2.LB > box.f2.UB ) return;
+            if ( !LPFacets.empty ( ) && !ShrinkBox ( box ) )
+            {
+                ++theStatistics->NumberOfPrunedBoxes;
+                return;
+            }
+            REPBOX rb;
+            rb.Box  = box;
+            rb.Gain = ( box.f1.UB - box.f1.LB + 1.0 ) * ( box.f2.UB - box.f2.LB + 1.0 );
+            boxes.push ( rb );
+            UnexploredArea += BoxArea ( box );
+        };
+
+        // The interior of every triangle is a box
+        for ( auto it = NonDomSet.SupNDs.begin ( ); NonDomSet.SupNDs.size ( ) > 1 && std::next ( it ) != NonDomSet.SupNDs.end ( ); ++it )
+        {
+            BOUNDS FirstBounds;
+            FirstBounds.f1.LB = it->getFirst ( ) + 1.0;
+            FirstBounds.f1.UB = std::next ( it )->getFirst ( ) - 1.0;
+            FirstBounds.f2.LB = std::next ( it )->getSecond ( ) + 1.0;
+            FirstBounds.f2.UB = it->getSecond ( ) - 1.0;
+            PushBox ( FirstBounds );
+        }
+
+        while ( !boxes.empty ( ) && NonDomSet.NDs.size ( ) < RepresentationSize && theStatistics->NumberOfSolves < RepresentationBudget )
+        {
+            BOUNDS CurrentBounds = boxes.top ( ).Box;
+            boxes.pop ( );
+            UnexploredArea -= BoxArea ( CurrentBounds );
+
+            endTime = CPUclock::now ( );
+            TimeUntilNow = std::chrono::duration_cast<duration<double>>(endTime - StartTime);
+            if ( TimeUntilNow.count ( ) > totalTime )
+            {
+                UnexploredArea += BoxArea ( CurrentBounds );
+                TimedOut = true;
+                break;
+            }
+
+            // Weights given by the diagonal of the box, so the outcome found lies in the middle of it
+            theModel.setObjectiveBounds ( CurrentBounds.f1.LB , CurrentBounds.f1.UB , CurrentBounds.f2.LB , CurrentBounds.f2.UB );
+            theModel.setWeights ( CurrentBounds.f2.UB - CurrentBounds.f2.LB + 1.0 , CurrentBounds.f1.UB - CurrentBounds.f1.LB + 1.0 );
+            if ( !Solve ( theModel , ( CurrentBounds.f1.UB - CurrentBounds.f1.LB ) * ( CurrentBounds.f2.UB - CurrentBounds.f2.LB ) , SUBPROBLEM_BOX ) ) continue;
+            theStatistics->NumberOfBranchingNodes += theModel.cplex.getNnodes();
+
+            p.first = theModel.cplex.getValue( theModel.f1 );
+            p.second = theModel.cplex.getValue( theModel.f2 );
+            for ( IloInt i = 0; i < theModel.AllVars.getSize ( ); ++i )
+            {
+                VarValues.push_back( theModel.cplex.getValue ( theModel.AllVars[i] ) );
+            }
+            NonDomSet.updateNDS( solution ( false , p , VarValues ) );
+            VarValues.clear ( );
+
+            // Split the box at p as in the PSM method
+            BOUNDS leftBounds, rightBounds;
+            leftBounds.f1.LB = CurrentBounds.f1.LB;
+            leftBounds.f1.UB = UncoveredBelow ( p.first );
+            leftBounds.f2.LB = p.second + 1.0;
+            leftBounds.f2.UB = CurrentBounds.f2.UB;
+            PushBox ( leftBounds );
+            rightBounds.f1.LB = p.first + 1.0;
+            rightBounds.f1.UB = CurrentBounds.f1.UB;
+            rightBounds.f2.LB = CurrentBounds.f2.LB;
+            rightBounds.f2.UB = UncoveredBelow ( p.second );
+            PushBox ( rightBounds );
+        }
+
+        // Phase one may have found more outcomes than wanted
+        if ( NonDomSet.NDs.size ( ) > RepresentationSize ) ThinFrontier ( RepresentationSize );
+        NonDomSet.recomputeHyperVolume ( );
+
+        theStatistics->TotalNumberOfSolutions = NonDomSet.NDs.size ( );
+        theStatistics->NumberOfPhaseTwoSolutions = ( theStatistics->TotalNumberOfSolutions > theStatistics->NumberOfPhaseOneSolutions ) ?
+                                                    theStatistics->TotalNumberOfSolutions - theStatistics->NumberOfPhaseOneSolutions : 0;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception in RunPhaseTwoRepresentation in the tpm class : " << e.what ( ) << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+    catch ( IloException &ie )
+    {
+        std::cerr << "IloException in RunPhaseTwoRepresentation in the tpm class : " << ie.getMessage ( )  << std::endl;
+        exit ( EXIT_FAILURE );
+    }
+}
+
+/********************************************************************************************/
+void tpm::ThinFrontier ( size_t k )
+{
+    std::vector< solution > points ( NonDomSet.NDs.begin ( ) , NonDomSet.NDs.end ( ) );
+    if ( points.size ( ) <= k || points.size ( ) < 2 ) return;
+
+    // Scale both objectives to [0,1] using the extreme outcomes
+    double range1 = std::max ( myTol , points.back ( ).getFirst ( ) - points.front ( ).getFirst ( ) );
+    double range2 = std::max ( myTol , points.front ( ).getSecond ( ) - points.back ( ).getSecond ( ) );
+    auto distance = [&] ( const solution &a, const solution &b )
+    {
+        double x = ( a.getFirst ( ) - b.getFirst ( ) ) / range1;
+        double y = ( a.getSecond ( ) - b.getSecond ( ) ) / range2;
+        return x*x + y*y;
+    };
+
+    // Farthest point selection, starting from the two extremes
+    std::vector< bool > keep ( points.size ( ) , false );
+    std::vector< double > nearest ( points.size ( ) , std::numeric_limits<double>::max ( ) );
+    keep.front ( ) = true;
+    size_t kept = 1, last = 0, next = points.size ( ) - 1;
+    while ( kept < k )
+    {
+        keep[next] = true;
+        ++kept;
+        last = next;
+        double farthest = -1.0;
+        for ( size_t i = 0; i < points.size ( ); ++i )
+        {
+            if ( keep[i] ) continue;
+            nearest[i] = std::min ( nearest[i] , std::min ( distance ( points[i] , points[last] ) , distance ( points[i] , points.front ( ) ) ) );
+            if ( nearest[i] > farthest )
+            {
+                farthest = nearest[i];
+                next = i;
+            }
+        }
+    }
+
+    // Remove the outcomes not kept, from the supported outcomes as well. The phase one outcomes removed no longer count
+    size_t Supported = NonDomSet.SupNDs.size ( );
+    NonDomSet.retain ( keep );
+    unsigned long Dropped = Supported - NonDomSet.SupNDs.size ( );
+    theStatistics->NumberOfPhaseOneSolutions -= std::min ( Dropped , theStatistics->NumberOfPhaseOneSolutions );
+}
+
 /********************************************************************************************/
 void tpm::printToFile( const std::string& fileName )
 {
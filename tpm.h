@@ -57,26 +57,83 @@
 #include<ilcplex/ilocplex.h>
 #include<stdexcept>
 #include<chrono>
+#include<algorithm>
+#include<functional>
+#include<mutex>
 
 //! My own C++ includes
 #include"NDS.h" //! Implementation of a non domminated set
 #include"solution.h" //! Implementation of a solution class to hold a solution
 #include"CplexModel.h" //! Implememntation of the class holding the cplex model
+#include"ThreadBudget.h" //! Coordination of cplex threads between workers
+#include"PostProcessor.h" //! Background thread for the work following a solve
+#include"LineChannel.h" //! Sockets used to distribute phase two over several processes
+#include"BoxQueue.h" //! Pending boxes with a bound on the memory used
+#include"Logger.h" //! Levelled asynchronous logging
 
 typedef IloArray<IloNumVarArray>    IloVarMatrix;
 using namespace std::chrono;
 typedef std::chrono::high_resolution_clock CPUclock;
 
+enum SubproblemClass{
+    SUBPROBLEM_LEXICOGRAPHIC,   //!< Lexicographic minimisation of one objective, solved to find the end points of the frontier in phase one
+    SUBPROBLEM_WEIGHTED,        //!< Weighted sum of the objectives over the whole outcome space, solved by NISE in phase one and in phase zero
+    SUBPROBLEM_BOX,             //!< Weighted sum restricted to a box of phase two (PSM method, epsilon constraint, balanced box, slabs, workers and representation)
+    SUBPROBLEM_RANKING,         //!< Re-solve of the ranking algorithm after a no good inequality is added
+    SUBPROBLEM_LP,              //!< LP relaxation, solved for the LP relaxation lower bound set and for reduced cost fixing
+    NUMBER_OF_SUBPROBLEM_CLASSES
+}; //!< Classes of subproblems, each solved with its own ParameterProfile
+
+struct ParameterProfile{
+    IloInt PreInd       = 1;    //!< Presolve on (1) or off (0)
+    IloInt Reduce       = 0;    //!< Reductions of presolve: none (0), primal (1), dual (2) or both (3)
+    IloInt MIPEmphasis  = 0;    //!< Emphasis of the branch and cut: balanced (0), feasibility (1), optimality (2), best bound (3) or hidden feasibility (4)
+    IloInt Probe        = 0;    //!< Probing: off (-1), automatic (0) or moderate to very aggressive (1 to 3)
+    IloInt HeurFreq     = 0;    //!< Node heuristic: off (-1), automatic (0) or every k nodes (k)
+    IloInt NodeSel      = 1;    //!< Node selection: depth first (0), best bound (1), best estimate (2) or alternative best estimate (3)
+}; //!< Struct used to hold the cplex parameters of a class of subproblems. They change how fast cplex solves, never the solution returned, as the gaps stay zero
+
 struct testStatistics{
     unsigned long NumberOfBranchingNodes;       //!< Total number of branching nodes
     unsigned long NumberOfPhaseOneSolutions;    //!< Number of solutions generated in phase one
     unsigned long NumberOfPhaseTwoSolutions;    //!< Number of solutions generated in phase two
     unsigned long TotalNumberOfSolutions;       //!< Total number of solutions (in objective space) on the non--dominated frontier
+    double PhaseZeroTime;                       //!< Time in seconds used by the heuristic phase zero
     double PhaseOneTime;                        //!< Time in seconds used in phase one
     double PhaseTwoTime;                        //!< Time in seconds used in phase two
-    double TotalTime;                           //!< Total time used on the entire algorithm
+    double TotalTime;                           //!< Total time used on the entire algorithm, including the check of the previous frontier (see setPreviousFrontier)
+    unsigned long NumberOfSolves;               //!< Number of times cplex was called
+    double ThreadsPerSolve;                     //!< Average number of threads cplex was allowed to use per solve. Zero means cplex decided itself
+    double CPUUtilisation;                      //!< Cpu time used by the process during the run divided by wall time times the number of cores. Zero if other runs shared the process
+    unsigned long NumberOfLPBoundPoints;        //!< Number of extreme points of the LP relaxation lower bound set
+    unsigned long NumberOfPrunedTriangles;      //!< Number of triangles discarded by the LP relaxation lower bound set without solving a MIP
+    unsigned long NumberOfPrunedBoxes;          //!< Number of PSM boxes discarded by the LP relaxation lower bound set without solving a MIP
+    double ApproximationEpsilon;                //!< The approximation factor used. Zero if the exact frontier was computed
+    bool ApproximationRelative;                 //!< True if ApproximationEpsilon is relative, false if it is absolute
+    bool ApproximationCertified;                //!< True if every non--dominated outcome is dominated by the frontier found, up to ApproximationEpsilon. False if the time limit stopped the algorithm, or if only a representation was computed
+    double HyperVolume;                         //!< Hypervolume of the frontier found, with respect to the nadir point of phase one plus one
+    double UnexploredArea;                      //!< Number of integer outcome vectors in the boxes (or triangles) not yet explored when the algorithm stopped. Zero after a complete run
+    unsigned long NumberOfPSMTriangles;         //!< Number of triangles solved by the perpendicular search method when the strategy is chosen per triangle
+    unsigned long NumberOfRankingTriangles;     //!< Number of triangles solved by ranking when the strategy is chosen per triangle
+    unsigned long NumberOfSlabs;                //!< Number of slabs searched in parallel when triangles are split into slabs
+    unsigned long NumberOfSpilledBoxes;         //!< Number of pending boxes written to disk because of the memory ceiling
+    unsigned long NumberOfSpilledSolutions;     //!< Number of solutions on the frontier whose decision vectors were written to disk because of the memory ceiling
+    bool PhaseOneLP;                            //!< True if phase one solved linear programs only, as the constraint matrix is totally unimodular
+    unsigned long NumberOfReusedSolutions;      //!< Number of solutions of the previous frontier which are feasible for the changed model, and were put on the frontier before phase two
+    unsigned long NumberOfRepairStarts;         //!< Number of supported solutions of the previous frontier which are infeasible for the changed model, and were handed to cplex to repair
+    unsigned long NumberOfPhaseZeroSolutions;   //!< Number of non-dominated solutions found by the heuristic phase zero, which were put on the frontier before phase two
+    unsigned long NumberOfFixedVariables;       //!< Number of binary variables fixed by reduced costs, summed over the triangles of phase two
+    double SubproblemTime[NUMBER_OF_SUBPROBLEM_CLASSES];                //!< Time in seconds cplex used on each class of subproblems
+    unsigned long SubproblemSolves[NUMBER_OF_SUBPROBLEM_CLASSES];       //!< Number of subproblems of each class solved
 }; //!< Struct used to gather test statistics
 
+enum PhaseTwoEngine{
+    ENGINE_PSM,         //!< Perpendicular search method. The default
+    ENGINE_RANKING,     //!< Ranking of the solutions in each triangle by no good inequalities. Pure binary problems only
+    ENGINE_EPSILON,     //!< Epsilon constraint sweep in each triangle
+    ENGINE_BALANCED_BOX //!< Balanced box method in each triangle
+}; //!< Algorithms used in phase two to search the triangles between the supported outcomes
+
 
 class tpm{
     private:
@@ -91,6 +148,32 @@ class tpm{
             BOUND f2;
         }; //!< Struct used to specify bounds on both objective functions
 
+        struct LPFACET{
+            double l1;
+            double l2;
+            double rhs;
+        }; //!< Struct used to hold a facet l1*f1 + l2*f2 >= rhs of the LP relaxation lower bound set
+
+        struct STRATEGYMODEL{
+            double SecondsPerSolve;     //!< Average time of a solve
+            double SolvesPerPoint;      //!< Average number of solves per outcome found
+            unsigned long Observations; //!< Number of triangles observed
+        }; //!< Struct used to predict the cost of a phase two strategy in a triangle
+
+        struct MODELSTATE{
+            BOUND f1;
+            BOUND f2;
+            double TimeLimit;
+            double W1;
+            double W2;
+            std::ostream *Out;
+            std::ostream *Warning;
+            ParameterProfile Profile;
+            IloInt ClockType;
+            IloInt Threads;
+            int MIPStarts;
+        }; //!< Struct used to remember the parts of the CplexModel which are changed by RUN, so they can be restored afterwards
+
 
         CPUclock::time_point StartTime;
 
@@ -103,12 +186,44 @@ class tpm{
             double myTol;       //!< Tolerance for equality.
             //double TimeLeft;    //!< Time left to use by cplex!
             int problemtype;    //!< Indicating the problem type
-            bool PrintProgress; //!< Prints the progress in the Ranking based two phase method
+            LogRate ProgressRate; //!< Limits how often the progress of phase two is logged
             double totalTime;   //!< Variable holding the time limit for the whole solve
             bool PrintToFile;     //!< True if solutions should be printed to file. Default is false
             std::string FileName; //!< Name of the file, which should printed to
-            bool DoRanking;     //!< If true, the rannking based two phase method is used. Default is false, meaning the perpendicular search method is used in phase two as default.
+            PhaseTwoEngine Engine; //!< Algorithm used in phase two. Default is the perpendicular search method
             bool TakeFront;     //!< If true, the stack of problems generated in the PSM method is taken on a FIFO principle. Otherwise, FILO principle
+            int Threads;        //!< Number of threads cplex may use in each solve. Zero (default) lets cplex decide
+            bool UseLPBound;    //!< If true, the LP relaxation lower bound set is used to discard and shrink triangles and boxes in phase two. Default is false
+            double Epsilon;     //!< Approximation factor of the PSM method. Zero (default) means the exact frontier is computed
+            bool RelativeEpsilon; //!< If true, Epsilon is relative to the size of the outcome. Otherwise it is absolute. Default is false
+            bool TimedOut;      //!< Set to true if the time limit stopped the algorithm
+            size_t RepresentationSize;          //!< Number of outcomes wanted in representation mode. Zero (default) means the whole frontier is computed
+            unsigned long RepresentationBudget; //!< Largest number of cplex solves used in representation mode
+            double UnexploredArea;              //!< Number of integer outcome vectors in the boxes (or triangles) not yet explored in phase two
+            bool AdaptiveStrategy;              //!< If true, phase two chooses between the PSM method and ranking for each triangle. Default is false
+            unsigned long RankingIterations;    //!< Number of outcomes ranked so far. Used for printing the progress
+            double PointsPerWidth;              //!< Observed number of outcomes per unit of the width of a triangle
+            CPUclock::time_point PhaseTwoStartTime; //!< Time phase two started
+            bool AsyncPostProcessing;           //!< If true, phase two updates the non-dominated set and prints the progress on a background thread. Default is true
+            PostProcessor Pipeline;             //!< Runs the work following a solve in phase two
+            int CoordinatorPort;                //!< If positive, phase two hands the boxes to worker processes connecting on this port. Default is 0
+            std::string CoordinatorAddress;     //!< Address of the interface the coordinator listens on. Default is the loopback interface
+            double WorkerWait;                  //!< Seconds the coordinator waits without a ready worker before it solves boxes itself. Default is 60
+            int Slabs;                          //!< Number of slabs a triangle is split into when there are fewer triangles than slabs. Default is 1, that is no splitting
+            std::function< void ( CplexModel& ) > BuildSlabModel; //!< Builds a copy of the model for each slab. If empty, the slab models are built from SlabData
+            std::shared_ptr< const ModelData > SlabData; //!< Data of the model passed to RUN, shared by the slab models when BuildSlabModel is empty
+            std::mutex SharedStateMutex;        //!< Protects the non-dominated set, UnexploredArea and the statistics while slabs are searched
+            size_t MemoryCeiling;               //!< Memory in bytes used by pending boxes and decision vectors before they are written to disk. Zero means no limit. Default is 0
+            bool TotallyUnimodular;             //!< If true, the constraint matrix is known to be totally unimodular, and phase one solves linear programs. Default is false
+            bool DetectTotallyUnimodular;       //!< If true, RUN tests if the constraint matrix is totally unimodular before phase one. Default is false
+            std::list< solution > PreviousFrontier; //!< Frontier of an earlier run on a slightly different instance. Empty (default) means RUN starts from scratch
+            std::list< solution > Seeds;        //!< Solutions of PreviousFrontier and of phase zero which are feasible for the current model, with their outcome vectors recomputed
+            int PhaseZeroWeights;               //!< Number of weighted sums solved briefly in phase zero. Default is 0
+            double PhaseZeroSeconds;            //!< Time limit in seconds of each solve of phase zero. Default is 1
+            std::function< void ( std::list< solution >& ) > PhaseZeroHeuristic; //!< Problem specific heuristic run in phase zero. Empty by default
+            bool ReducedCostFixing;             //!< If true, binary variables are fixed by reduced costs in each triangle of phase two. Default is false
+            bool IntegerOutcomes;               //!< If true, the frontier keeps integer outcome vectors (see NDS::setIntegerCoordinates). Default is true
+            std::vector< ParameterProfile > Profiles; //!< The parameters used for each class of subproblems, indexed by SubproblemClass
         ///@}
 
         /**
@@ -124,6 +239,10 @@ class tpm{
          * This section contains all the data structures used in the two phase method
          */
          NDS NonDomSet;
+         std::vector< LPFACET > LPFacets; //!< Facets of the LP relaxation lower bound set. Empty if it has not been computed
+         std::vector< std::pair< double , double > > LPExtremePoints; //!< Extreme points of the LP relaxation lower bound set
+         STRATEGYMODEL PSMModel;         //!< Cost model of the PSM method when the strategy is chosen per triangle
+         STRATEGYMODEL RankingModel;     //!< Cost model of ranking when the strategy is chosen per triangle
         ///@{
 
         /*! \brief Runs the Non-Inferior Set Estimation algorithm as a first phase.
@@ -144,6 +263,311 @@ class tpm{
          * Generates all the solutions which are not found in phase one by ranking the solutions in the triangles
          */
         void RunPhaseTwoRanking ( CplexModel &theModel );
+
+        /*! \brief Runs an epsilon constraint sweep in a single triangle
+         *
+         * Minimises f2 subject to f1 <= epsilon, starting with epsilon just left of right. Each solve finds the non-dominated outcome with the largest first
+         * objective value left of epsilon, and epsilon is moved to just left of it, until no outcome is left. Ties are broken by SolveLexicographic, so
+         * each non-dominated outcome costs a single solve, plus one solve which ends the sweep.
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param left constant reference to a solution. The supported outcome with the smaller first objective value
+         * \param right constant reference to a solution. The supported outcome following left
+         * \return bool. False if the time limit was reached
+         */
+        bool ProcessTriangleEpsilon ( CplexModel &theModel, const solution &left, const solution &right );
+
+        /*! \brief Runs the balanced box method in a single triangle
+         *
+         * Works on rectangles whose upper left and lower right corners are known outcomes, starting with the triangle. A rectangle is split at the middle of
+         * its f2 range. The lexicographic minimum of (f1,f2) in the lower half and the lexicographic minimum of (f2,f1) in the part of the upper half left of it
+         * are found, and the two rectangles between these outcomes and the corners are searched in the same way. Every solve finds an outcome, as a corner is
+         * always feasible, and the rectangles shrink evenly.
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param left constant reference to a solution. The supported outcome with the smaller first objective value
+         * \param right constant reference to a solution. The supported outcome following left
+         * \return bool. False if the time limit was reached
+         */
+        bool ProcessTriangleBalancedBox ( CplexModel &theModel, const solution &left, const solution &right );
+
+        /*! \brief Finds the lexicographic minimum in a box with a single solve
+         *
+         * Minimises the primary objective plus delta times the secondary objective, where delta is one over the range of the secondary objective in the box
+         * plus one. As outcome vectors are integral, this gives the lexicographic minimum.
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param box constant reference to a BOUNDS. The bounds on f1 and f2
+         * \param f1First bool. If true, f1 is the primary objective. Otherwise f2 is
+         * \param p reference to a pair of doubles. Holds the outcome vector on output
+         * \return bool. False if the box holds no feasible solution
+         */
+        bool SolveLexicographic ( CplexModel &theModel, const BOUNDS &box, bool f1First, std::pair<double,double> &p );
+
+        /*! \brief Runs the perpendicular search method in a single triangle
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param left constant reference to a solution. The supported outcome with the smaller first objective value
+         * \param right constant reference to a solution. The supported outcome following left
+         * \return bool. False if the time limit was reached
+         */
+        bool ProcessTrianglePSM ( CplexModel &theModel, const solution &left, const solution &right );
+
+        /*! \brief Ranks the solutions in a single triangle
+         *
+         * Ranks the solutions in the triangle by adding no good inequalities, until the weighted value exceeds the worst local nadir point.
+         * The no good inequalities are removed again before the function returns.
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param left constant reference to a solution. The supported outcome with the smaller first objective value
+         * \param right constant reference to a solution. The supported outcome following left
+         * \return bool. False if the time limit was reached
+         */
+        bool ProcessTriangleRanking ( CplexModel &theModel, const solution &left, const solution &right );
+
+        /*! \brief Runs phase two choosing between the PSM method and ranking for each triangle
+         *
+         * The cost of a strategy in a triangle is predicted as the time per solve times the expected number of solves. The expected number
+         * of solves is the number of solves per outcome times the expected number of outcomes, which is estimated from the width of the triangle.
+         * For ranking it is increased by the gap of the LP relaxation in the triangle, as a large gap means many dominated solutions are ranked.
+         * The time per solve, the solves per outcome and the outcomes per width are updated after each triangle.
+         */
+        void RunPhaseTwoAdaptive ( CplexModel &theModel );
+
+        /*!
+         * Returns the gap between the weighted value of the supported outcomes of a triangle and the LP relaxation, relative to the depth of the triangle. Zero if the LP bound has not been computed
+         */
+        double TriangleLPGap ( const solution &left, const solution &right ) const;
+
+        /*! \brief Fixes binary variables by their reduced costs in the weighted LP relaxation of a triangle
+         *
+         * Every outcome searched in the triangle lies in the box spanned by left and right, so its weighted value is at most the weighted value of the
+         * local nadir point (right.f1,left.f2). The LP relaxation restricted to the box is solved once with the weights of the triangle. A binary variable
+         * at zero in the LP solution with reduced cost d > 0 can only be one in solutions of weighted value at least z_LP + d, and likewise for a variable at one
+         * with d < 0. If that exceeds the nadir value, the variable is fixed at its LP value.
+         * \param theModel reference to a CplexModel object
+         * \param left constant reference to a solution object. The upper left point of the triangle
+         * \param right constant reference to a solution object. The lower right point of the triangle
+         * \param fixed reference to a vector of integers. Holds the indices (into AllVars) of the fixed variables on return
+         */
+        void FixByReducedCosts ( CplexModel &theModel, const solution &left, const solution &right, std::vector< IloInt > &fixed );
+
+        /*! \brief Releases the fixings of FixByReducedCosts, so all binary variables may again be zero or one
+         * \param theModel reference to a CplexModel object
+         * \param fixed reference to a vector of integers. The indices returned by FixByReducedCosts. Empty on return
+         */
+        void ReleaseFixings ( CplexModel &theModel, std::vector< IloInt > &fixed );
+
+        /*!
+         * Sets UnexploredArea to the number of integer outcome vectors in all triangles
+         */
+        void InitUnexploredArea ( );
+
+        /*! \brief Creates the first box of the perpendicular search method in a triangle
+         *
+         * With the LP relaxation lower bound set the box is the interior of the triangle, so its last column f1 = right.f1 - 1 holds no outcome found
+         * yet. SplitBox keeps the right child while a single column is left, so outcomes on that column are still searched.
+         * \param left constant reference to a solution. The supported outcome with the smaller first objective value
+         * \param right constant reference to a solution. The supported outcome following left
+         * \param FirstBounds reference to a BOUNDS. Holds the box on return
+         * \return bool. False if the LP relaxation lower bound set shows the triangle holds no new outcomes
+         */
+        bool FirstTriangleBox ( const solution &left, const solution &right, BOUNDS &FirstBounds );
+
+        /*! \brief Creates the boxes to the left and to the right of an outcome found in a box
+         *
+         * Boxes which cannot hold an outcome, or which are pruned by the LP relaxation lower bound set, are not created. The area of the boxes created is added to UnexploredArea.
+         * The bounds of a box are inclusive, so a child is created whenever a single integer column or row of it is left.
+         * \param CurrentBounds constant reference to a BOUNDS. The box searched
+         * \param p constant reference to a pair of doubles. The outcome found in CurrentBounds
+         * \param children reference to a vector of BOUNDS. Holds the new boxes on return
+         */
+        void SplitBox ( const BOUNDS &CurrentBounds, const std::pair<double,double> &p, std::vector< BOUNDS > &children );
+
+        /*! \brief Runs the perpendicular search method in a triangle split into slabs, which are searched in parallel
+         *
+         * The range of the first objective of the triangle is split into Slabs slabs of equal width. Each slab is searched by the perpendicular search method
+         * in its own thread using its own copy of the model. Outcomes found in one slab are inserted into the shared non-dominated set, and the boxes of the
+         * other slabs are tightened using them before they are solved.
+         * \param left constant reference to a solution. The supported outcome with the smaller first objective value
+         * \param right constant reference to a solution. The supported outcome following left
+         * \return bool. False if the time limit was reached
+         */
+        bool ProcessTriangleSlabs ( const solution &left, const solution &right );
+
+        /*! \brief Searches the boxes of a single slab. Runs in its own thread
+         * \param boxes reference to a BoxQueue of BOUNDS. The boxes of the slab
+         * \param lambda1 double. Weight of the first objective in the triangle
+         * \param lambda2 double. Weight of the second objective in the triangle
+         * \param NumberOfSlabs integer. Number of slabs searched at the same time
+         */
+        void RunSlab ( BoxQueue< BOUNDS > &boxes, double lambda1, double lambda2, int NumberOfSlabs );
+
+        /*!
+         * Returns the number of pending boxes kept in memory, that is half the memory ceiling divided by the size of a box. Zero means no limit
+         */
+        size_t MaxBoxesInMemory ( ) const { return MemoryCeiling == 0 ? 0 : std::max< size_t > ( 1 , MemoryCeiling / 2 / sizeof ( BOUNDS ) ); }
+
+        /*! \brief Removes the parts of a box dominated by the non-dominated set found so far
+         *
+         * The bounds stay inclusive: f1.UB and f2.UB become the last column and row not covered by an outcome, which may still hold outcomes not found yet.
+         * \param box reference to a BOUNDS. The box to tighten
+         * \return bool. False if the box is empty after tightening
+         */
+        bool TightenBox ( BOUNDS &box ) const;
+
+        /*! \brief Runs the perpendicular search method with the boxes solved by worker processes
+         *
+         * Listens for workers on CoordinatorPort. Every idle worker is handed the next box in the queue, which holds the boxes of all triangles,
+         * so work is balanced over the workers as they finish. The outcomes found are inserted into the non-dominated set here, and the new boxes are put in the queue.
+         * A worker gets boxes only after its HELLO shows it holds a model with as many variables as theModel. An answer which cannot be parsed, has the wrong number
+         * of variables or an outcome outside the box is dropped and the worker is disconnected. A box handed to a worker which leaves, or which is dropped, is put back in the queue.
+         * When no worker has been ready for WorkerWait seconds, the coordinator solves the boxes itself, one at a time, until a worker is ready again.
+         * The time limit is the one of the perpendicular search method, that is totalTime for phase two and one hour for the whole run.
+         */
+        void RunPhaseTwoDistributed ( CplexModel &theModel );
+
+        /*! \brief Runs phase two in representation mode
+         *
+         * Keeps a queue of boxes from all triangles, ordered by their area, which bounds the hypervolume a new outcome in the box can add.
+         * The box with the largest area is solved using weights given by its diagonal, so the outcome found lies in the middle of the box, and is split as in the PSM method.
+         * Stops when RepresentationSize outcomes are found, when RepresentationBudget solves are used or when no boxes are left.
+         */
+        void RunPhaseTwoRepresentation ( CplexModel &theModel );
+
+        /*! \brief Reduces the frontier to a number of well spread outcomes
+         *
+         * Keeps the two extreme outcomes and repeatedly adds the outcome farthest (in objectives scaled to [0,1]) from those kept, until k outcomes are kept.
+         * \param k size_t. The number of outcomes to keep
+         */
+        void ThinFrontier ( size_t k );
+
+        /*! \brief Runs phase one on the LP relaxation of a totally unimodular model
+         *
+         * When the constraint matrix is totally unimodular, every extreme point of the LP relaxation is integral, so the extreme supported
+         * outcomes are the extreme points of the LP relaxation lower bound set. They are found by the NISE algorithm of ComputeLPBoundSet, where each
+         * weighted LP is solved by the primal simplex method starting from the basis of the previous one.
+         * \param theModel reference to a CplexModel object
+         * \return bool. False if the LP relaxation could not be solved, in which case RunPhaseOne should be called instead
+         */
+        bool RunPhaseOneLP ( CplexModel &theModel );
+
+        /*! \brief Tests a sufficient condition for the constraint matrix to be totally unimodular
+         *
+         * The rows added through the bulk building functions of CplexModel, apart from the rows defining f1 and f2, are tested. The matrix is totally
+         * unimodular if all coefficients are 0, 1 or -1, each column has at most two nonzeros, and the rows can be split into two sets, so that
+         * the two nonzeros of a column are in different sets if they have the same sign, and in the same set otherwise.
+         * Bounds on the rows and variables must be integral, and all variables must be integer.
+         * \param theModel reference to a CplexModel object
+         * \return bool. True if the condition holds. False does not mean that the matrix is not totally unimodular
+         */
+        bool IsTotallyUnimodular ( CplexModel &theModel ) const;
+
+        /*! \brief Checks solutions against the current model and keeps the feasible ones as seeds of the frontier
+         *
+         * Integer variables of each solution are rounded, and all variables are moved inside their bounds. The rows added through
+         * the bulk building functions of CplexModel are then evaluated. Feasible solutions are appended to Seeds, with f1 and f2 computed from their defining rows.
+         * If the model holds constraints which are not in Rows (see CplexModel::rowsCoverModel), nothing is appended to Seeds and the solutions are only used as MIP starts.
+         * Solutions of an earlier run: the supported ones are added as MIP starts, so phase one starts from them, and infeasible ones are added with the repair effort,
+         * so cplex tries to repair them. Heuristic solutions: the feasible ones are added as MIP starts.
+         * \param theModel reference to a CplexModel object
+         * \param candidates constant reference to a list of solutions holding their variable values
+         * \param previousRun bool. True if the candidates are the frontier of an earlier run, false if they are found by phase zero
+         */
+        void SeedFrontier ( CplexModel &theModel, const std::list< solution > &candidates, bool previousRun );
+
+        /*! \brief Runs the heuristic phase zero
+         *
+         * Collects candidate solutions from the problem specific heuristic and from short solves of PhaseZeroWeights weighted sums, including every solution
+         * in the cplex solution pool. The non-dominated candidates are handed to SeedFrontier.
+         * \param theModel reference to a CplexModel object
+         */
+        void RunPhaseZero ( CplexModel &theModel );
+
+        /*! \brief Creates the boxes of a triangle not dominated by the frontier found so far
+         *
+         * Used when the frontier has been seeded by an earlier run. Between consecutive outcomes z and z' on the frontier inside the triangle, an outcome which is
+         * not dominated has z_1 <= y_1 < z'_1 and y_2 < z_2. These boxes cover the part of the triangle where the frontier may have changed, and an unchanged part is confirmed
+         * by a single solve which finds the box empty.
+         * \param outer constant reference to a BOUNDS. The box of the triangle
+         * \param left constant reference to a solution. The upper left corner of the triangle
+         * \param right constant reference to a solution. The lower right corner of the triangle
+         * \param boxes reference to a vector of BOUNDS. Holds the boxes on return
+         */
+        void StaircaseBoxes ( const BOUNDS &outer, const solution &left, const solution &right, std::vector< BOUNDS > &boxes );
+
+        /*! \brief Computes the extreme points of the lower bound set of the LP relaxation
+         *
+         * Runs a NISE algorithm on the LP relaxation of the model. The outcomes found are the extreme points of the LP relaxation lower bound set,
+         * sorted by increasing value of the first objective.
+         * \param theModel reference to a CplexModel object. The model is relaxed while the function runs and unrelaxed when it returns
+         * \param Extremes reference to a list of solutions. Holds the extreme points on output
+         * \param KeepVarValues bool. If true, the values of AllVars are stored in each solution
+         * \return bool. False if the LP relaxation could not be solved, or if the iteration cap stopped the algorithm before every segment between
+         * consecutive extreme points was verified to be a facet. Extremes is empty in both cases
+         */
+        bool ComputeLPBoundSet ( CplexModel &theModel, std::list< solution > &Extremes, bool KeepVarValues );
+
+        /*! \brief Builds the facets of the LP relaxation lower bound set from its extreme points
+         * \param Extremes constant reference to a list of solutions sorted by increasing value of the first objective
+         */
+        void SetLPFacets ( const std::list< solution > &Extremes );
+
+        /*! \brief Shrinks a box using the LP relaxation lower bound set
+         *
+         * Raises the lower bounds of the box to the smallest integer values allowed by the facets of the LP relaxation lower bound set,
+         * given the upper bounds of the box. If a lower bound ends above the upper bound, no feasible outcome lies in the box.
+         * \param box reference to a BOUNDS struct. The box, which is shrunk on output
+         * \return bool. False if the box provably contains no feasible outcome
+         */
+        bool ShrinkBox ( BOUNDS &box ) const;
+
+        /*! \brief Returns the largest integer value below value which is not covered by value
+         *
+         * An outcome y is covered by a found outcome z if z_k <= y_k + Epsilon (absolute) or z_k <= y_k + Epsilon*|y_k| (relative) for both objectives.
+         * When the PSM method splits a box at a found outcome z, the new boxes only need to contain the values of each objective which are not covered by z.
+         * \param value double. The value of one objective in the found outcome
+         * \return double. The new upper bound on the objective. Equals value - 1 in exact mode
+         */
+        double UncoveredBelow ( double value ) const;
+
+        /*!
+         * Returns the number of integer outcome vectors in a box. Used to track the area left to explore
+         */
+        static double BoxArea ( const BOUNDS &box ) { return std::max ( 0.0 , box.f1.UB - box.f1.LB + 1.0 ) * std::max ( 0.0 , box.f2.UB - box.f2.LB + 1.0 ); }
+
+        /*!
+         * Returns the box spanned by two consecutive supported outcomes, left having the smaller first objective value
+         */
+        static BOUNDS TriangleBox ( const solution &left, const solution &right );
+
+        /*! \brief Solves the current subproblem
+         *
+         * All subproblems are solved through this function. It sets the number of threads cplex may use (as set by setThreads or, if that is zero,
+         * as decided by the global ThreadBudget), calls cplex and collects statistics.
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param boxArea double. Area of the box in objective space the subproblem is restricted to. IloInfinity if not restricted
+         * \param sub SubproblemClass. The class of the subproblem. Its ParameterProfile is applied before cplex is called
+         * \return bool. The return value of IloCplex::solve ( )
+         */
+        bool Solve ( CplexModel &theModel, double boxArea, SubproblemClass sub );
+
+        /*! \brief Sets the parameters of a profile on a model
+         *
+         * Uses the fast modification functions of CplexModel, so parameters which are already set are not given to cplex again.
+         * \param theModel reference to a CplexModel object
+         * \param profile constant reference to a ParameterProfile
+         */
+        static void ApplyProfile ( CplexModel &theModel, const ParameterProfile &profile );
+
+        /*! \brief Stores the bounds on f1 and f2, the weights in OBJ, the cplex output streams and the parameters changed by RUN
+         * \param theModel reference to a CplexModel object. The model whose state is saved
+         * \param state reference to a MODELSTATE struct. Holds the state on output
+         */
+        void SaveModelState ( CplexModel &theModel, MODELSTATE &state );
+
+        /*! \brief Restores the CplexModel to the state it had before RUN was called
+         *
+         * Resets the bounds on f1 and f2, the weights of f1 and f2 in OBJ, the output and warning streams of cplex and the cplex parameters changed by RUN.
+         * \param theModel reference to a CplexModel object. The model which should be restored
+         * \param state constant reference to a MODELSTATE struct. The state saved by SaveModelState
+         */
+        void RestoreModelState ( CplexModel &theModel, const MODELSTATE &state );
     public:
         /*!
          * Default constructor setting default values for parameters and flags.
@@ -163,6 +587,33 @@ class tpm{
          */
         int RUN( CplexModel &theModel );
 
+        /*! \brief Runs as a worker for a coordinator distributing phase two
+         *
+         * Connects to a coordinator, that is a tpm object on which distributePhaseTwo was called, and solves the boxes it is handed until the coordinator is done.
+         * theModel must hold the same instance as the model of the coordinator.
+         *
+         * The protocol is lines of text. The coordinator sends "BOX lambda1 lambda2 f1LB f1UB f2LB f2UB" and "END".
+         * The worker sends "HELLO n", where n is the number of variables in AllVars, when it connects, and answers each box by "SOL nodes f1 f2 n x_1 ... x_n" or "INF nodes".
+         * A BOX line which cannot be read makes the worker disconnect.
+         * \param theModel reference to a CplexModel object. The model to solve
+         * \param host string. Name or address of the coordinator
+         * \param port integer. The port the coordinator listens on
+         * \return int. Zero if the worker finished without errors
+         */
+        int RUNWorker ( CplexModel &theModel, const std::string &host, int port );
+
+        /*! \brief Clears the frontier and the test statistics
+         *
+         * Clears the non--dominated set and the test statistics so the tpm object can be used for a new run. Parameters and flags are kept.
+         * RUN calls reset () itself, so calling it explicitly is only needed in order to release the memory held by the frontier.
+         */
+        void reset ( );
+
+        /*! \brief Returns the non--dominated frontier found by the last call to RUN
+         * \return constant reference to a list of solutions sorted by increasing value of the first objective
+         */
+        const std::list< solution >& getNonDominatedSet ( ) const { return NonDomSet.NDs; }
+
         /*! \brief Sets a time limit for the whole algorithm.
          *
          * Sets a time limit for the entire algorithm. It does, however, not terminate the cplex search when time is up, but
@@ -173,9 +624,14 @@ class tpm{
         void setTimeLimit ( double timeLimit ){ totalTime = timeLimit; }
 
         /*!
-         * Tells the algorithm to print progress of phase two to the screen
+         * Tells the algorithm to print progress of phase two to the screen, by raising the level of the global logger to LOG_PROGRESS
+         */
+        void printProgress ( ) { if ( !Logger::global ( ).isEnabled ( LOG_PROGRESS ) ) Logger::global ( ).setLevel ( LOG_PROGRESS ); }
+
+        /*! \brief Sets the minimum time between two progress messages
+         * \param seconds double. Zero logs every triangle and every ranked solution. Default is one second
          */
-        void printProgress ( ) { PrintProgress = true; }
+        void setProgressInterval ( double seconds ) { ProgressRate.setInterval ( seconds ); }
 
         /*! \brief Sets a file for printing solution info
          * Sets the internal falg PrintToFile = true and stores the fileName so that results are printet to this file.
@@ -189,15 +645,217 @@ class tpm{
          * a solution value exceeds the value of the worst local Nadir point in the corresponding triangle. Can potentially work better than default
          * PSM method on problems with a totally unimodular constraint matrix.
          */
-        void doRanking ( ) { DoRanking = true; }
+        void doRanking ( ) { Engine = ENGINE_RANKING; }
+
+        /*! \brief Sets the algorithm used in phase two
+         *
+         * ENGINE_PSM (default) runs the perpendicular search method, ENGINE_RANKING is the same as doRanking ( ), ENGINE_EPSILON runs an epsilon constraint
+         * sweep in each triangle, which needs a single solve per non-dominated outcome and no boxes. It works best when the frontier is dense.
+         * ENGINE_BALANCED_BOX runs the balanced box method in each triangle, which splits rectangles evenly and never solves an infeasible subproblem.
+         * All but the perpendicular search method always compute the exact frontier, and do not split triangles into slabs.
+         * \param engine PhaseTwoEngine. The algorithm
+         */
+        void setPhaseTwoEngine ( PhaseTwoEngine engine ) { Engine = engine; }
 
         /*! \brief Specifies the order in which subproblems are processed in the PSM method
          *
-         * Specifies to do a depth first search in the PSM method. If doRanking () has been called prior to calling setFILO () it has no effect.
+         * Specifies to do a depth first search in the PSM method. It has no effect on the other phase two engines.
          * Default is a best bound search.
          */
         void setDepthFirst ( ) { TakeFront = false; }
 
+        /*! \brief Uses the LP relaxation lower bound set in phase two
+         *
+         * After phase one, the lower bound set of the LP relaxation is computed by a NISE algorithm. In phase two, triangles and boxes
+         * which provably contain no outcome are discarded without solving a MIP, and the remaining ones are shrunk.
+         */
+        void useLPBound ( ) { UseLPBound = true; }
+
+        /*! \brief Computes an approximation of the frontier instead of the exact frontier
+         *
+         * Makes the PSM method skip the part of each box which is covered by the outcome found in the box, that is, outcomes y for which the found outcome z
+         * satisfies z_k <= y_k + epsilon (absolute) or z_k <= y_k + epsilon*|y_k| (relative) in both objectives. When RUN finishes within the time limit,
+         * every non--dominated outcome is covered by the returned frontier, which is certified by the flag ApproximationCertified in the test statistics.
+         * The ranking algorithm always computes the exact frontier.
+         * \param epsilon double. The approximation factor. For instance 0.01 and relative = true gives a 1% approximation
+         * \param relative bool. If true, epsilon is relative to the size of the outcomes. Otherwise it is absolute
+         */
+        void setApproximation ( double epsilon, bool relative );
+
+        /*! \brief Computes a representation of the frontier instead of the whole frontier
+         *
+         * Makes RUN return about k well spread outcomes of the frontier. After phase one, boxes are chosen by the hypervolume they can add,
+         * and phase two stops when k outcomes are found or when the total number of cplex solves reaches solveBudget. If more than k outcomes are
+         * found (for instance in phase one), the frontier is thinned to k outcomes spread as evenly as possible.
+         * \param k size_t. The number of outcomes wanted. Zero turns representation mode off
+         * \param solveBudget unsigned long. Largest number of cplex solves, including those of phase one
+         */
+        void setRepresentation ( size_t k, unsigned long solveBudget ) { RepresentationSize = k; RepresentationBudget = solveBudget; }
+
+        /*! \brief Chooses the phase two algorithm for each triangle
+         *
+         * Makes phase two choose between the perpendicular search method and ranking for each triangle, using a cost model which is
+         * updated with the observed solve times as the algorithm runs. As ranking is used, the problem MUST be a pure binary optimization problem.
+         * Works best together with useLPBound ( ), as the gap of the LP relaxation is used to predict the cost of ranking.
+         */
+        void chooseStrategyPerTriangle ( ) { AdaptiveStrategy = true; }
+
+        /*! \brief Turns the background thread for the work following a solve on or off
+         *
+         * When on, the non-dominated set is updated and the progress is printed on a background thread in phase two, while cplex solves the next subproblem.
+         * Only the outcome vector, which is needed to create the next subproblems, is retrieved before the next solve.
+         * \param async boolean. Default is true
+         */
+        void setAsyncPostProcessing ( bool async ) { AsyncPostProcessing = async; }
+
+        /*! \brief Splits triangles into slabs which are searched in parallel
+         *
+         * When phase one finds fewer triangles than k, which happens when the objectives are correlated, each triangle is split into k slabs
+         * along the first objective, and the slabs are searched by the perpendicular search method in parallel. Cplex models cannot be shared between threads,
+         * so build is called once in each slab thread to build a copy of the model. The slabs share the non-dominated set, and outcomes found in one slab tighten the boxes of the others.
+         * \param k integer. Number of slabs. One turns splitting off. Default is 1
+         * \param build function taking a reference to an empty CplexModel. Must build the same instance as the model passed to RUN
+         */
+        void setSlabs ( int k, std::function< void ( CplexModel& ) > build ) { Slabs = k; BuildSlabModel = build; }
+
+        /*! \brief Splits triangles into slabs, building the slab models from the data of the model passed to RUN
+         *
+         * Same as setSlabs ( k , build ), but each slab thread builds its copy of the model by CplexModel::build from the ModelData recorded by the
+         * bulk building functions (see CplexModel::getModelData). The data is shared between the slabs, and no user code is called.
+         * If the model has no recorded data, or was changed since it was recorded (for instance by model.add), triangles are not split.
+         * \param k integer. Number of slabs. One turns splitting off. Default is 1
+         */
+        void setSlabs ( int k ) { Slabs = k; BuildSlabModel = nullptr; }
+
+        /*! \brief Sets a ceiling on the memory used by pending boxes and decision vectors
+         *
+         * Half the ceiling is used by the pending boxes of the perpendicular search method. Beyond it, chunks of the boxes which are taken last are written
+         * to a temporary file and read back in order. The other half is used by the decision vectors of the solutions on the frontier. Beyond it, they are moved
+         * to a log in a temporary file, and read back when they are needed, for instance when the frontier is printed. The outcome vectors are always kept in memory.
+         * \param bytes size_t. The ceiling in bytes. Zero means no limit, which is the default
+         */
+        void setMemoryCeiling ( size_t bytes ) { MemoryCeiling = bytes; }
+
+        /*! \brief Tells that the constraint matrix is totally unimodular
+         *
+         * Makes phase one find the extreme supported outcomes by solving the LP relaxation for each weight vector instead of a MIP, as every
+         * extreme point of the LP relaxation is integral. Each LP is solved by the primal simplex method starting from the basis of the previous one.
+         * Bounds on the constraints and the variables must be integral. Phase two is unchanged.
+         */
+        void setTotallyUnimodular ( ) { TotallyUnimodular = true; }
+
+        /*! \brief Tests if the constraint matrix is totally unimodular before phase one
+         *
+         * Same as setTotallyUnimodular ( ), but RUN first tests a sufficient condition on the rows added through the bulk building functions of CplexModel
+         * (see IsTotallyUnimodular). If it does not hold, phase one solves MIPs as usual.
+         * \note Constraints added directly to the model are not seen by the test. Do not use this if the model has such constraints.
+         */
+        void detectTotallyUnimodular ( ) { DetectTotallyUnimodular = true; }
+
+        /*! \brief Re-optimises from the frontier of an earlier run
+         *
+         * Used when the instance differs only slightly from the one the frontier was computed for, for instance in a capacity or a few profits.
+         * The solutions are checked against the current model (see SeedFrontier). The feasible ones are put on the frontier after phase one, and
+         * phase one starts cplex from the previous supported solutions. The perpendicular search method then only searches the boxes between consecutive
+         * outcomes on the frontier, where outcomes may have appeared or disappeared. The result is the exact frontier of the current model.
+         * The previous frontier is used by every following call of RUN, until an empty list is passed.
+         * \param previous constant reference to a list of solutions, for instance a copy of getNonDominatedSet ( ) after the earlier run. The solutions must hold their variable values
+         * \note Constraints added directly to the model are not seen by the check. Do not use this if the model has such constraints.
+         */
+        void setPreviousFrontier ( const std::list< solution > &previous ) { PreviousFrontier = previous; }
+
+        /*! \brief Runs a heuristic phase zero before phase one
+         *
+         * Solves k weighted sums of the objectives, with weights spread evenly from ( 1 , 0 ) to ( 0 , 1 ), with a time limit of seconds each, and collects
+         * every solution in the cplex solution pool. The non-dominated solutions found are added as MIP starts of phase one and put on the frontier after phase one,
+         * so the perpendicular search method only searches the boxes between them. The frontier found is still exact.
+         * \param k integer. Number of weighted sums. Zero (default) turns the solves off
+         * \param seconds double. Time limit of each solve. Default is 1
+         */
+        void setPhaseZero ( int k, double seconds ) { PhaseZeroWeights = k; PhaseZeroSeconds = seconds; }
+
+        /*! \brief Sets a problem specific heuristic for phase zero
+         *
+         * The heuristic appends solutions, holding the values of all variables in AllVars and their outcome vectors, to the list it is given. Only the non-dominated
+         * ones are used, and they are checked against the model, which recomputes their outcome vectors. See BOKPHeuristic for a heuristic for the problem built by CplexModel::buildBOKP.
+         * \param heuristic function taking a reference to a list of solutions. An empty function turns the heuristic off
+         */
+        void setPhaseZeroHeuristic ( std::function< void ( std::list< solution >& ) > heuristic ) { PhaseZeroHeuristic = heuristic; }
+
+        /*! \brief Fixes binary variables by reduced costs in each triangle of phase two
+         *
+         * Before a triangle is searched, its weighted LP relaxation is solved once, and the binary variables which cannot change value without the
+         * weighted objective exceeding the local nadir point of the triangle are fixed (see FixByReducedCosts). The fixings are released before the next
+         * triangle. Used by the PSM method, ranking, the epsilon constraint method and the balanced box method, but not by slabs or distributed phase two.
+         */
+        void useReducedCostFixing ( ) { ReducedCostFixing = true; }
+
+        /*! \brief Turns the integer outcome mode of the frontier on or off
+         *
+         * With integer objective coefficients and integer variables, all outcome vectors are integral. The frontier then rounds each outcome once,
+         * compares them exactly and rejects duplicates through a hash index (see NDS::setIntegerCoordinates). If an outcome further than the tolerance
+         * from the integers turns up, the frontier falls back to the tolerance compares by itself, so the default (on) is safe for any model.
+         * \param on bool. False to always use the tolerance compares
+         */
+        void setIntegerOutcomes ( bool on ) { IntegerOutcomes = on; }
+
+        /*! \brief Sets the cplex parameters used for a class of subproblems
+         *
+         * The lexicographic end points of phase one, the weighted sums of NISE, the boxes of phase two, the ranking re-solves and the LP relaxations
+         * behave very differently, so each class has its own presolve, reduction, emphasis, probing, heuristic and node selection settings.
+         * The default profile of every class (presolve on without primal and dual reductions, everything else automatic) is what RUN used before profiles existed.
+         * The gaps are always zero, so no profile changes the frontier found. RUN restores the parameters of the model before it returns.
+         * \param sub SubproblemClass. The class of subproblems
+         * \param profile constant reference to a ParameterProfile. The parameters used for the class
+         */
+        void setProfile ( SubproblemClass sub, const ParameterProfile &profile ) { Profiles[sub] = profile; }
+
+        /*!
+         * Returns the cplex parameters used for a class of subproblems
+         */
+        const ParameterProfile& getProfile ( SubproblemClass sub ) const { return Profiles[sub]; }
+
+        /*! \brief Reads the profiles of the subproblem classes from a file
+         *
+         * Each line holds the name of a class (see SubproblemClassName) followed by key=value pairs, where the keys are presolve, reduce, emphasis,
+         * probe, heurfreq and nodesel. Parameters not mentioned keep their current value. Lines starting with # are comments.
+         * This is the format written by saveProfiles and by the auto-tuner in tuner/ProfileTuner.cpp.
+         * \param FileName constant reference to a string. Name of the file
+         * \return bool. False if the file could not be opened or has a line which could not be read. The lines read before the error are kept
+         */
+        bool loadProfiles ( const std::string &FileName );
+
+        /*! \brief Writes the profiles of all subproblem classes to a file, in the format read by loadProfiles
+         * \param FileName constant reference to a string. Name of the file
+         * \return bool. False if the file could not be written
+         */
+        bool saveProfiles ( const std::string &FileName ) const;
+
+        /*!
+         * Returns the name of a class of subproblems, as used in profile files and in the log: lexicographic, weighted, box, ranking or lp
+         */
+        static const char* SubproblemClassName ( SubproblemClass sub );
+
+        /*! \brief Distributes phase two over worker processes
+         *
+         * Makes RUN act as a coordinator. Phase one is run as usual, while the boxes of the perpendicular search method are handed to worker processes
+         * which connect on port and call RUNWorker. Workers may connect and leave at any time during phase two. Several workers may run on one machine.
+         * There is no authentication, so by default only workers on the same machine can connect. Listen on another interface only inside a trusted network.
+         * \param port integer. The TCP port to listen on. Zero turns distribution off. Default is 0
+         * \param address string. IPv4 address of the interface to listen on. Default is "127.0.0.1". "0.0.0.0" listens on all interfaces
+         * \param workerWait double. Seconds without a ready worker after which the coordinator solves boxes itself. Default is 60
+         */
+        void distributePhaseTwo ( int port, const std::string &address = "127.0.0.1", double workerWait = 60.0 ) { CoordinatorPort = port; CoordinatorAddress = address; WorkerWait = workerWait; }
+
+        /*! \brief Sets the number of threads cplex may use
+         *
+         * Sets the number of threads cplex may use in every solve of the algorithm. Default is zero, meaning cplex uses all available cores.
+         * When several tpm objects run at the same time, this should be set so that the total does not exceed the number of cores,
+         * or the global ThreadBudget should be enabled by calling ThreadBudget::global ( ).setCores ( ), in which case Threads should be left at zero.
+         * \param threads integer. The number of threads. Zero lets cplex decide.
+         */
+        void setThreads ( int threads ) { Threads = threads; }
+
         /*! \brief Returns the test statistics
          *
          * Returns a point to a testStatistics struct. The struct contains test statistics obtained throughout the algorithm.
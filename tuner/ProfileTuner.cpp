@@ -0,0 +1,181 @@
+/**
+ * Offline tuning of the parameter profiles of the two phase method.
+ *
+ * A set of benchmark instances of the bi-objective knapsack problem (generated as in main.cpp, one seed per instance) is solved with the
+ * current profiles. Then, for each class of subproblems, one parameter at a time is set to each of its candidate values, and the instances are
+ * solved again. A value is kept if it lowers the time cplex spends on that class, summed over the instances, by more than the noise threshold.
+ * Every run must find a frontier of the same size as the first run, otherwise the tuner stops. The profiles found are written in the format read
+ * by tpm::loadProfiles, and can be used by main.cpp through --profiles.
+ *
+ * Compile from the root of the repository with the include and library flags of CPLEX and Concert, as for main.cpp:
+ *      g++ -std=c++11 -O3 -DIL_STD -I. tuner/ProfileTuner.cpp tpm.cpp CplexModel.cpp NDS.cpp solution.cpp SpillLog.cpp Logger.cpp
+ *          ThreadBudget.cpp PostProcessor.cpp LineChannel.cpp <cplex flags> -pthread -o ProfileTuner
+ * Usage:
+ *      ./ProfileTuner [--instances k] [--items n] [--rounds r] [--threshold fraction] [--in file] [--out file]
+ */
+
+//! C++ includes
+#include<iostream>
+#include<iomanip>
+#include<vector>
+#include<string>
+#include<random>
+#include<memory>
+#include<cstdlib>
+
+//! My own C++ includes
+#include"tpm.h"
+#include"CplexModel.h"
+
+struct PARAMETER{
+    const char *Name;                       //!< Key of the parameter in the profile file
+    IloInt ParameterProfile::*Field;        //!< The field of ParameterProfile
+    std::vector< IloInt > Candidates;       //!< Values tried by the tuner
+    bool MIPOnly;                           //!< True if the parameter has no effect on linear programs
+}; //!< Struct describing a parameter searched by the tuner
+
+struct EVALUATION{
+    double Time[NUMBER_OF_SUBPROBLEM_CLASSES];  //!< Seconds spent by cplex on each class, summed over the instances
+    double TotalTime;                           //!< Seconds used by RUN, summed over the instances
+    std::vector< size_t > FrontierSizes;        //!< Size of the frontier of each instance
+}; //!< Struct used to hold the result of solving all instances with one set of profiles
+
+/********************************************************************************************/
+/*      Benchmark instances                                                                 */
+/********************************************************************************************/
+void BuildInstance ( CplexModel &theModel, int n, std::mt19937_64::result_type seed )
+{
+    std::mt19937_64 generator ( seed );
+    std::uniform_int_distribution<> Weight ( 10 , 50 );
+    std::uniform_int_distribution<> Profit ( 1 , 100 );
+    std::vector< int > w, p1, p2;
+    double weightSum = 0.0;
+    for ( int i = 0; i < n; ++i )
+    {
+        w.push_back ( Weight ( generator ) );
+        p1.push_back ( Profit ( generator ) );
+        p2.push_back ( Profit ( generator ) );
+        weightSum += w[i];
+    }
+    theModel.buildBOKP ( n , int ( weightSum / 2.0 ) , w , p1 , p2 );
+}
+
+/********************************************************************************************/
+EVALUATION Evaluate ( std::vector< std::unique_ptr< CplexModel > > &models, const std::vector< ParameterProfile > &profiles )
+{
+    EVALUATION result;
+    result.TotalTime = 0.0;
+    for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub ) result.Time[sub] = 0.0;
+    for ( auto model = models.begin ( ); model != models.end ( ); ++model )
+    {
+        tpm twoPhaseMethod;
+        for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub ) twoPhaseMethod.setProfile ( SubproblemClass ( sub ) , profiles[sub] );
+        twoPhaseMethod.RUN ( **model ); // RUN restores the parameters of the model, so the next evaluation starts from the same state
+        testStatistics *TS = twoPhaseMethod.getTestStatistics ( );
+        for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub ) result.Time[sub] += TS->SubproblemTime[sub];
+        result.TotalTime += TS->TotalTime;
+        result.FrontierSizes.push_back ( TS->TotalNumberOfSolutions );
+    }
+    return result;
+}
+
+/********************************************************************************************/
+/*      Coordinate search over the profiles                                                 */
+/********************************************************************************************/
+int main ( int argc, char** argv )
+{
+    try
+    {
+        int     Instances   = 5,    // Number of benchmark instances
+                Items       = 40,   // Number of items in each instance
+                Rounds      = 2;    // Number of passes over all classes and parameters
+        double  Threshold   = 0.03; // A value must save this fraction of the time of its class to be kept
+        std::string InFile, OutFile = "profiles.txt";
+        for ( int a = 1; a < argc; ++a )
+        {
+            std::string arg = argv[a];
+            if ( arg == "--instances" && a + 1 < argc ) Instances = std::stoi ( argv[++a] );
+            else if ( arg == "--items" && a + 1 < argc ) Items = std::stoi ( argv[++a] );
+            else if ( arg == "--rounds" && a + 1 < argc ) Rounds = std::stoi ( argv[++a] );
+            else if ( arg == "--threshold" && a + 1 < argc ) Threshold = std::stod ( argv[++a] );
+            else if ( arg == "--in" && a + 1 < argc ) InFile = argv[++a];
+            else if ( arg == "--out" && a + 1 < argc ) OutFile = argv[++a];
+        }
+
+        const std::vector< PARAMETER > Parameters = {
+            { "presolve" , &ParameterProfile::PreInd      , { 0 , 1 }             , false },
+            { "reduce"   , &ParameterProfile::Reduce      , { 0 , 1 , 2 , 3 }     , false },
+            { "emphasis" , &ParameterProfile::MIPEmphasis , { 0 , 1 , 2 , 3 }     , true  },
+            { "probe"    , &ParameterProfile::Probe       , { -1 , 0 , 1 , 2 , 3 }, true  },
+            { "heurfreq" , &ParameterProfile::HeurFreq    , { -1 , 0 , 10 }       , true  },
+            { "nodesel"  , &ParameterProfile::NodeSel     , { 0 , 1 , 2 , 3 }     , true  }
+        };
+
+        // Each instance is built once. RUN leaves the model as it found it
+        std::vector< std::unique_ptr< CplexModel > > models;
+        for ( int k = 0; k < Instances; ++k )
+        {
+            models.push_back ( std::unique_ptr< CplexModel > ( new CplexModel ( ) ) );
+            BuildInstance ( *models.back ( ) , Items , k );
+        }
+
+        // Start from the default profiles, or from a file written by an earlier tuning
+        tpm Defaults;
+        if ( !InFile.empty ( ) && !Defaults.loadProfiles ( InFile ) ) return 1;
+        std::vector< ParameterProfile > Profiles;
+        for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub ) Profiles.push_back ( Defaults.getProfile ( SubproblemClass ( sub ) ) );
+
+        EVALUATION Best = Evaluate ( models , Profiles );
+        const EVALUATION Baseline = Best;
+        std::cout << std::fixed << std::setprecision ( 3 ) << "baseline total=" << Best.TotalTime << "\n";
+
+        for ( int round = 1; round <= Rounds; ++round )
+        {
+            bool Improved = false;
+            for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub )
+            {
+                if ( Baseline.Time[sub] <= 0.0 ) continue; // The class is not solved on these instances
+                const char *ClassName = tpm::SubproblemClassName ( SubproblemClass ( sub ) );
+                for ( auto param = Parameters.begin ( ); param != Parameters.end ( ); ++param )
+                {
+                    if ( param->MIPOnly && sub == SUBPROBLEM_LP ) continue;
+                    IloInt Current = Profiles[sub].*( param->Field );
+                    for ( auto value = param->Candidates.begin ( ); value != param->Candidates.end ( ); ++value )
+                    {
+                        if ( *value == Current ) continue;
+                        std::vector< ParameterProfile > Trial ( Profiles );
+                        Trial[sub].*( param->Field ) = *value;
+                        EVALUATION result = Evaluate ( models , Trial );
+                        if ( result.FrontierSizes != Baseline.FrontierSizes )
+                        {
+                            std::cerr << "The frontier changed with " << ClassName << " " << param->Name << "=" << *value << ". Stopping" << std::endl;
+                            return 1;
+                        }
+                        bool Keep = ( result.Time[sub] < ( 1.0 - Threshold ) * Best.Time[sub] );
+                        std::cout << "round=" << round << " class=" << ClassName << " " << param->Name << "=" << *value
+                                  << " time=" << result.Time[sub] << " best=" << Best.Time[sub] << ( Keep ? " kept" : "" ) << "\n";
+                        if ( Keep )
+                        {
+                            Profiles = Trial;
+                            Best = result;
+                            Current = *value;
+                            Improved = true;
+                        }
+                    }
+                }
+            }
+            if ( !Improved ) break; // A full pass without improvement. The search has converged
+        }
+
+        // Write the profiles found
+        for ( int sub = 0; sub < NUMBER_OF_SUBPROBLEM_CLASSES; ++sub ) Defaults.setProfile ( SubproblemClass ( sub ) , Profiles[sub] );
+        if ( !Defaults.saveProfiles ( OutFile ) ) return 1;
+        std::cout << "tuned total=" << Best.TotalTime << " baseline total=" << Baseline.TotalTime << " written to " << OutFile << std::endl;
+        return 0;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "Exception : " << e.what ( ) << std::endl;
+        return 1;
+    }
+}